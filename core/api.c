@@ -0,0 +1,210 @@
+// core/api.c
+
+#include "othello_core.h"
+#include "board.h"
+#include "evaluate.h"
+#include "search.h"
+#include <stdlib.h>
+
+struct OthelloEngine {
+    SearchContext search;
+};
+
+OTHELLO_API int othello_api_version(void) {
+    return OTHELLO_CORE_API_VERSION;
+}
+
+OTHELLO_API const char* othello_status_string(OthelloStatus status) {
+    switch (status) {
+        case OTHELLO_OK:
+            return "ok";
+        case OTHELLO_ERROR_INVALID_ARGUMENT:
+            return "invalid argument";
+        case OTHELLO_ERROR_UNKNOWN_EVALUATOR:
+            return "unknown evaluator";
+        case OTHELLO_ERROR_ILLEGAL_MOVE:
+            return "illegal move";
+        case OTHELLO_ERROR_OUT_OF_MEMORY:
+            return "out of memory";
+        case OTHELLO_ERROR_IO:
+            return "i/o error";
+    }
+    return "unknown status";
+}
+
+OTHELLO_API OthelloPosition othello_initial_position(void) {
+    OthelloPosition position;
+    position.player = (1ULL << 28) | (1ULL << 35);
+    position.opponent = (1ULL << 27) | (1ULL << 36);
+    return position;
+}
+
+OTHELLO_API uint64_t othello_legal_moves(const OthelloPosition* position) {
+    return get_moves_mask(position->player, position->opponent);
+}
+
+OTHELLO_API uint64_t othello_flips(const OthelloPosition* position, int move) {
+    if (move < 0 || move >= 64) {
+        return 0;
+    }
+    return get_flip_mask(move, position->player, position->opponent);
+}
+
+OTHELLO_API bool othello_is_game_over(const OthelloPosition* position) {
+    return get_moves_mask(position->player, position->opponent) == 0 &&
+           get_moves_mask(position->opponent, position->player) == 0;
+}
+
+OTHELLO_API OthelloStatus othello_make_move(OthelloPosition* position, int move) {
+    uint64_t legal = get_moves_mask(position->player, position->opponent);
+
+    if (move == OTHELLO_PASS) {
+        if (legal != 0) {
+            return OTHELLO_ERROR_ILLEGAL_MOVE;
+        }
+    } else {
+        if (move < 0 || move >= 64 || !((legal >> move) & 1ULL)) {
+            return OTHELLO_ERROR_ILLEGAL_MOVE;
+        }
+        uint64_t flips = get_flip_mask(move, position->player, position->opponent);
+        position->player |= flips | (1ULL << move);
+        position->opponent &= ~flips;
+    }
+
+    uint64_t player = position->player;
+    position->player = position->opponent;
+    position->opponent = player;
+    return OTHELLO_OK;
+}
+
+OTHELLO_API OthelloStatus othello_evaluate(const char* evaluator, const OthelloPosition* position, int* score) {
+    EvalFunc func = find_eval_func(evaluator);
+    if (func == NULL) {
+        return OTHELLO_ERROR_UNKNOWN_EVALUATOR;
+    }
+    *score = func(position->player, position->opponent);
+    return OTHELLO_OK;
+}
+
+OTHELLO_API void othello_search_options_init(OthelloSearchOptions* options) {
+    options->max_depth = 3;
+    options->alpha_beta = true;
+    options->debug = false;
+    options->evaluator = "combined_evaluate";
+    options->nnue_weights = NULL;
+    options->time_limit_ms = 0;
+    options->mpc_params = NULL;
+    options->mpc_confidence = 1.5;
+    options->endgame_empties = 0;
+    options->shared_table = NULL;
+    options->eval_terms = NULL;
+    options->eval_term_count = 0;
+    options->eval_params = NULL;
+    options->eval_cache_mb = 0;
+}
+
+OTHELLO_API OthelloStatus othello_shared_table_create(const char* name, size_t size_mb) {
+    char error[256];
+    return shared_table_create(name, size_mb, error, sizeof(error));
+}
+
+OTHELLO_API OthelloStatus othello_shared_table_destroy(const char* name) {
+    char error[256];
+    return shared_table_destroy(name, error, sizeof(error));
+}
+
+OTHELLO_API OthelloEngine* othello_engine_create(const OthelloSearchOptions* options, OthelloStatus* status) {
+    OthelloEngine* engine = (OthelloEngine*)malloc(sizeof(OthelloEngine));
+    if (engine == NULL) {
+        if (status) {
+            *status = OTHELLO_ERROR_OUT_OF_MEMORY;
+        }
+        return NULL;
+    }
+
+    char error[256];
+    OthelloStatus result = search_context_init(&engine->search, options, error, sizeof(error));
+    if (status) {
+        *status = result;
+    }
+    if (result != OTHELLO_OK) {
+        free(engine);
+        return NULL;
+    }
+    return engine;
+}
+
+OTHELLO_API void othello_engine_destroy(OthelloEngine* engine) {
+    if (engine == NULL) {
+        return;
+    }
+    search_context_free(&engine->search);
+    free(engine);
+}
+
+OTHELLO_API OthelloStatus othello_engine_search(OthelloEngine* engine, const OthelloPosition* position, OthelloSearchResult* result) {
+    if (engine == NULL || position == NULL || result == NULL) {
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    engine->search.iter = 0;
+    engine->search.stop_requested = 0;
+
+    RootMoveList root_moves;
+    if (engine->search.time_limit_ms > 0) {
+        result->score = search_iterative(&engine->search, position->player, position->opponent, &root_moves);
+    } else {
+        result->score = search_root_moves(&engine->search, position->player, position->opponent, &root_moves);
+    }
+
+    result->best_move = root_moves.best_index >= 0 ? root_moves.moves[root_moves.best_index].move : OTHELLO_PASS;
+    result->depth = root_moves.depth;
+    result->nodes = engine->search.iter;
+    return OTHELLO_OK;
+}
+
+OTHELLO_API OthelloStatus othello_engine_analyze(OthelloEngine* engine, const OthelloPosition* position,
+                                                 OthelloMoveAnalysis* moves, int* count) {
+    if (engine == NULL || position == NULL || moves == NULL || count == NULL) {
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    engine->search.iter = 0;
+    engine->search.stop_requested = 0;
+
+    RootMoveList root_moves;
+    search_analyze(&engine->search, position->player, position->opponent, &root_moves);
+
+    for (int i = 0; i < root_moves.count; i++) {
+        const RootMove* root_move = &root_moves.moves[i];
+        moves[i].move = root_move->move;
+        moves[i].score = root_move->score;
+        moves[i].pv_length = root_move->pv_length;
+        for (int j = 0; j < root_move->pv_length; j++) {
+            moves[i].pv[j] = root_move->pv[j];
+        }
+    }
+    *count = root_moves.count;
+    return OTHELLO_OK;
+}
+
+OTHELLO_API void othello_engine_eval_cache_stats(const OthelloEngine* engine, uint64_t* hits, uint64_t* misses) {
+    const EvalCache* cache = engine->search.eval_cache;
+    *hits = cache ? cache->hits : 0;
+    *misses = cache ? cache->misses : 0;
+}
+
+OTHELLO_API void othello_engine_stop(OthelloEngine* engine) {
+    search_request_stop(&engine->search);
+}
+
+OTHELLO_API OthelloStatus othello_search(const OthelloPosition* position, const OthelloSearchOptions* options, OthelloSearchResult* result) {
+    OthelloStatus status;
+    OthelloEngine* engine = othello_engine_create(options, &status);
+    if (engine == NULL) {
+        return status;
+    }
+    status = othello_engine_search(engine, position, result);
+    othello_engine_destroy(engine);
+    return status;
+}
@@ -0,0 +1,227 @@
+// core/board.c
+
+#include "board.h"
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+OTHELLO_API int popcount64(uint64_t x) {
+    return (int)__popcnt64(x);
+}
+
+#elif defined(__GNUC__) || defined(__clang__)
+OTHELLO_API int popcount64(uint64_t x) {
+    return __builtin_popcountll(x);
+}
+#else
+OTHELLO_API int popcount64(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = x + (x >> 8);
+    x = x + (x >> 16);
+    x = x + (x >> 32);
+    return (int)(x & 0x7F);
+}
+#endif
+
+const Direction DIRECTIONS[8] = {
+    {-1, 0},  // Up
+    {1, 0},   // Down
+    {0, -1},  // Left
+    {0, 1},   // Right
+    {-1, -1}, // Up-Left
+    {-1, 1},  // Up-Right
+    {1, -1},  // Down-Left
+    {1, 1}    // Down-Right
+};
+
+OTHELLO_API bool is_valid_move(int move, uint64_t player_board, uint64_t opponent_board) {
+    uint64_t all_occupied = player_board | opponent_board;
+    if ((all_occupied >> move) & 1ULL) {
+        return false;
+    }
+
+    int move_row = move / BOARD_SIZE;
+    int move_col = move % BOARD_SIZE;
+    for (int i = 0; i < 8; i++) {
+        int dr = DIRECTIONS[i].dr;
+        int dc = DIRECTIONS[i].dc;
+        int r = move_row + dr;
+        int c = move_col + dc;
+        bool bits_to_flip = false;
+        while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
+            int bit = (r << 3) + c;
+            if ((opponent_board >> bit) & 1ULL) {
+                bits_to_flip = true;
+            } else if ((player_board >> bit) & 1ULL) {
+                if (bits_to_flip) {
+                    return true;
+                }
+                break;
+            } else {
+                break;
+            }
+            r += dr;
+            c += dc;
+        }
+    }
+    return false;
+}
+
+OTHELLO_API void get_valid_moves(uint64_t player_board, uint64_t opponent_board, MoveList* move_list) {
+    uint64_t all_occupied = player_board | opponent_board;
+    bool potential_moves[64] = {false};
+    for (int bit = 0; bit < 64; bit++) {
+        if ((opponent_board >> bit) & 1ULL) {
+            int row = bit / BOARD_SIZE;
+            int col = bit % BOARD_SIZE;
+            for (int i = 0; i < 8; i++) {
+                int dr = DIRECTIONS[i].dr;
+                int dc = DIRECTIONS[i].dc;
+                int r = row + dr;
+                int c = col + dc;
+                if (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
+                    int candidate_bit = (r << 3) + c;
+                    if (!((all_occupied >> candidate_bit) & 1ULL)) {
+                        potential_moves[candidate_bit] = true;
+                    }
+                }
+            }
+        }
+    }
+    move_list->count = 0;
+    for (int move = 0; move < 64; move++) {
+        if (potential_moves[move]) {
+            if (is_valid_move(move, player_board, opponent_board)) {
+                move_list->moves[move_list->count++] = move;
+            }
+        }
+    }
+}
+
+OTHELLO_API void get_flipped_bits(int move, uint64_t player_board, uint64_t opponent_board, BitList* bit_list) {
+    int move_row = move / BOARD_SIZE;
+    int move_col = move % BOARD_SIZE;
+    bit_list->count = 0;
+
+    for (int i = 0; i < 8; i++) {
+        int dr = DIRECTIONS[i].dr;
+        int dc = DIRECTIONS[i].dc;
+        int r = move_row + dr;
+        int c = move_col + dc;
+        int temp_flip[64];
+        int temp_count = 0;
+        while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
+            int bit = (r << 3) + c;
+            if ((opponent_board >> bit) & 1ULL) {
+                temp_flip[temp_count++] = bit;
+            } else if ((player_board >> bit) & 1ULL) {
+                if (temp_count > 0) {
+                    memcpy(&bit_list->bits[bit_list->count], temp_flip, temp_count * sizeof(int));
+                    bit_list->count += temp_count;
+                }
+                break;
+            } else {
+                break;
+            }
+            r += dr;
+            c += dc;
+        }
+    }
+}
+
+// Bitboard shifts for the 8 directions. Horizontal and diagonal runs are
+// masked to columns 1-6 so a run can never wrap around a row edge.
+#define INNER_COLUMNS 0x7E7E7E7E7E7E7E7EULL
+
+static const int SHIFTS[4] = {1, 8, 7, 9};
+static const uint64_t SHIFT_MASKS[4] = {INNER_COLUMNS, 0xFFFFFFFFFFFFFFFFULL, INNER_COLUMNS, INNER_COLUMNS};
+
+OTHELLO_API uint64_t get_moves_mask(uint64_t player_board, uint64_t opponent_board) {
+    uint64_t empty = ~(player_board | opponent_board);
+    uint64_t moves = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int shift = SHIFTS[i];
+        uint64_t mask = opponent_board & SHIFT_MASKS[i];
+
+        uint64_t left = mask & (player_board << shift);
+        uint64_t right = mask & (player_board >> shift);
+        for (int j = 0; j < 5; j++) {
+            left |= mask & (left << shift);
+            right |= mask & (right >> shift);
+        }
+        moves |= (left << shift) | (right >> shift);
+    }
+
+    return moves & empty;
+}
+
+OTHELLO_API uint64_t get_flip_mask(int move, uint64_t player_board, uint64_t opponent_board) {
+    uint64_t move_bit = 1ULL << move;
+    uint64_t flips = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int shift = SHIFTS[i];
+        uint64_t mask = opponent_board & SHIFT_MASKS[i];
+
+        uint64_t left = mask & (move_bit << shift);
+        uint64_t right = mask & (move_bit >> shift);
+        for (int j = 0; j < 5; j++) {
+            left |= mask & (left << shift);
+            right |= mask & (right >> shift);
+        }
+        if ((left << shift) & player_board) {
+            flips |= left;
+        }
+        if ((right >> shift) & player_board) {
+            flips |= right;
+        }
+    }
+
+    return flips;
+}
+
+#define EAST_EDGE_WRAP 0xFEFEFEFEFEFEFEFEULL
+#define WEST_EDGE_WRAP 0x7F7F7F7F7F7F7F7FULL
+
+// Per axis: squares a left/right shift may land on without wrapping, and the
+// squares whose neighbour along the axis is off the board.
+static const uint64_t STABLE_LEFT_MASKS[4] = {EAST_EDGE_WRAP, 0xFFFFFFFFFFFFFFFFULL, WEST_EDGE_WRAP, EAST_EDGE_WRAP};
+static const uint64_t STABLE_RIGHT_MASKS[4] = {WEST_EDGE_WRAP, 0xFFFFFFFFFFFFFFFFULL, EAST_EDGE_WRAP, WEST_EDGE_WRAP};
+static const uint64_t AXIS_BORDERS[4] = {
+    0x8181818181818181ULL, 0xFF000000000000FFULL, 0xFF818181818181FFULL, 0xFF818181818181FFULL
+};
+
+OTHELLO_API uint64_t get_stable_discs(uint64_t player_board, uint64_t opponent_board) {
+    uint64_t empty = ~(player_board | opponent_board);
+    uint64_t safe_axes[4];
+
+    // A full line cannot change, so every disc on it is safe along that axis.
+    for (int i = 0; i < 4; i++) {
+        int shift = SHIFTS[i];
+        uint64_t left = empty;
+        uint64_t right = empty;
+        for (int j = 0; j < 7; j++) {
+            left |= (left << shift) & STABLE_LEFT_MASKS[i];
+            right |= (right >> shift) & STABLE_RIGHT_MASKS[i];
+        }
+        safe_axes[i] = ~(left | right) | AXIS_BORDERS[i];
+    }
+
+    uint64_t stable = 0;
+    uint64_t previous;
+    do {
+        previous = stable;
+        uint64_t candidates = player_board;
+        for (int i = 0; i < 4; i++) {
+            int shift = SHIFTS[i];
+            candidates &= safe_axes[i] | ((stable << shift) & STABLE_LEFT_MASKS[i]) | ((stable >> shift) & STABLE_RIGHT_MASKS[i]);
+        }
+        stable = candidates;
+    } while (stable != previous);
+
+    return stable;
+}
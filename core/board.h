@@ -0,0 +1,41 @@
+// core/board.h
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "othello_core.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BOARD_SIZE 8
+
+typedef struct {
+    int dr;
+    int dc;
+} Direction;
+
+extern const Direction DIRECTIONS[8];
+
+typedef struct {
+    int moves[60];
+    int count;
+} MoveList;
+
+typedef struct {
+    int bits[64];
+    int count;
+} BitList;
+
+// Function declarations
+OTHELLO_API void get_valid_moves(uint64_t player_board, uint64_t opponent_board, MoveList* move_list);
+OTHELLO_API void get_flipped_bits(int move, uint64_t player_board, uint64_t opponent_board, BitList* bit_list);
+OTHELLO_API uint64_t get_moves_mask(uint64_t player_board, uint64_t opponent_board);
+OTHELLO_API uint64_t get_flip_mask(int move, uint64_t player_board, uint64_t opponent_board);
+OTHELLO_API int popcount64(uint64_t x);
+
+// Discs of player_board that can never be flipped: along each of the four
+// axes the line is full or a neighbour is the board edge or another stable disc.
+OTHELLO_API uint64_t get_stable_discs(uint64_t player_board, uint64_t opponent_board);
+OTHELLO_API bool is_valid_move(int move, uint64_t player_board, uint64_t opponent_board);
+
+#endif /* BOARD_H */
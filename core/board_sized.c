@@ -0,0 +1,272 @@
+// core/board_sized.c
+//
+// Generated kernels for the board sizes of OthelloSizedPosition. Each size
+// gets its own copy of board_sized_impl.h with the narrowest mask type that
+// holds its squares, so no size pays for the largest one. The 8x8 engine in
+// board.c and search.c is separate and unaffected.
+
+#include "othello_core.h"
+#include "board.h"
+#include "large_alloc.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIZED_TERMINAL_SCALE 1000
+#define SIZED_INFINITY 1000000
+// The exact solver's table: one entry per 2^empties up to 2^20 entries, at
+// least 2^10, probed from this many empties up.
+#define SIZED_TABLE_MIN_BITS 10
+#define SIZED_TABLE_MAX_BITS 20
+#define SIZED_TABLE_MIN_EMPTIES 6
+
+static inline int lowest_bit64(uint64_t x) {
+    return popcount64((x & (~x + 1)) - 1);
+}
+
+static inline uint64_t hash64(uint64_t player_board, uint64_t opponent_board) {
+    uint64_t h = player_board * 0x9E3779B97F4A7C15ULL ^ opponent_board * 0xC2B2AE3D27D4EB4FULL;
+    return h ^ (h >> 29);
+}
+
+#define SIZED_N 4
+#define SIZED_T uint16_t
+#define SIZED_FN(name) board4_##name
+#define SIZED_POPCOUNT(x) popcount64((uint64_t)(x))
+#define SIZED_LOWEST(x) lowest_bit64((uint64_t)(x))
+#define SIZED_HASH(p, o) hash64((uint64_t)(p), (uint64_t)(o))
+#include "board_sized_impl.h"
+#undef SIZED_N
+#undef SIZED_T
+#undef SIZED_FN
+
+#define SIZED_N 6
+#define SIZED_T uint64_t
+#define SIZED_FN(name) board6_##name
+#include "board_sized_impl.h"
+#undef SIZED_N
+#undef SIZED_FN
+
+#define SIZED_N 8
+#define SIZED_FN(name) board8_##name
+#include "board_sized_impl.h"
+#undef SIZED_N
+#undef SIZED_T
+#undef SIZED_FN
+#undef SIZED_POPCOUNT
+#undef SIZED_LOWEST
+#undef SIZED_HASH
+
+#if defined(__SIZEOF_INT128__)
+#define OTHELLO_HAVE_BOARD10 1
+typedef unsigned __int128 uint128_mask;
+
+static inline int popcount128(uint128_mask x) {
+    return popcount64((uint64_t)x) + popcount64((uint64_t)(x >> 64));
+}
+
+static inline int lowest_bit128(uint128_mask x) {
+    return (uint64_t)x ? lowest_bit64((uint64_t)x) : 64 + lowest_bit64((uint64_t)(x >> 64));
+}
+
+#define SIZED_N 10
+#define SIZED_T uint128_mask
+#define SIZED_FN(name) board10_##name
+#define SIZED_POPCOUNT(x) popcount128(x)
+#define SIZED_LOWEST(x) lowest_bit128(x)
+#define SIZED_HASH(p, o) hash64((uint64_t)(p) ^ (uint64_t)((p) >> 64) * 31, (uint64_t)(o) ^ (uint64_t)((o) >> 64) * 31)
+#include "board_sized_impl.h"
+#undef SIZED_N
+#undef SIZED_T
+#undef SIZED_FN
+#undef SIZED_POPCOUNT
+#undef SIZED_LOWEST
+#undef SIZED_HASH
+
+static inline uint128_mask to_mask128(const uint64_t* words) {
+    return ((uint128_mask)words[1] << 64) | words[0];
+}
+
+static inline void from_mask128(uint128_mask mask, uint64_t* words) {
+    words[0] = (uint64_t)mask;
+    words[1] = (uint64_t)(mask >> 64);
+}
+#else
+#define OTHELLO_HAVE_BOARD10 0
+#endif
+
+OTHELLO_API bool othello_sized_supported(int size) {
+    return size == 4 || size == 6 || size == 8 || (size == 10 && OTHELLO_HAVE_BOARD10);
+}
+
+OTHELLO_API OthelloStatus othello_sized_initial_position(int size, OthelloSizedPosition* position) {
+    if (!othello_sized_supported(size)) {
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    memset(position, 0, sizeof(*position));
+    position->size = size;
+    int center = size / 2;
+    int black[2] = {(center - 1) * size + center, center * size + center - 1};
+    int white[2] = {(center - 1) * size + center - 1, center * size + center};
+    for (int i = 0; i < 2; i++) {
+        position->player[black[i] / 64] |= 1ULL << (black[i] % 64);
+        position->opponent[white[i] / 64] |= 1ULL << (white[i] % 64);
+    }
+    return OTHELLO_OK;
+}
+
+// Legal moves and the flips of move (ignored when negative), in words.
+static bool sized_moves(const OthelloSizedPosition* position, int move, uint64_t* moves, uint64_t* flips) {
+    const uint64_t* p = position->player;
+    const uint64_t* o = position->opponent;
+    moves[1] = flips[1] = 0;
+    flips[0] = 0;
+
+    switch (position->size) {
+        case 4:
+            moves[0] = board4_moves((uint16_t)p[0], (uint16_t)o[0]);
+            if (move >= 0) {
+                flips[0] = board4_flips(move, (uint16_t)p[0], (uint16_t)o[0]);
+            }
+            return true;
+        case 6:
+            moves[0] = board6_moves(p[0], o[0]);
+            if (move >= 0) {
+                flips[0] = board6_flips(move, p[0], o[0]);
+            }
+            return true;
+        case 8:
+            moves[0] = board8_moves(p[0], o[0]);
+            if (move >= 0) {
+                flips[0] = board8_flips(move, p[0], o[0]);
+            }
+            return true;
+#if OTHELLO_HAVE_BOARD10
+        case 10:
+            from_mask128(board10_moves(to_mask128(p), to_mask128(o)), moves);
+            if (move >= 0) {
+                from_mask128(board10_flips(move, to_mask128(p), to_mask128(o)), flips);
+            }
+            return true;
+#endif
+    }
+    return false;
+}
+
+OTHELLO_API int othello_sized_legal_moves(const OthelloSizedPosition* position, int* moves) {
+    uint64_t mask[2];
+    uint64_t flips[2];
+    if (!sized_moves(position, -1, mask, flips)) {
+        return 0;
+    }
+
+    int count = 0;
+    for (int word = 0; word < 2; word++) {
+        while (mask[word]) {
+            moves[count++] = word * 64 + lowest_bit64(mask[word]);
+            mask[word] &= mask[word] - 1;
+        }
+    }
+    return count;
+}
+
+OTHELLO_API OthelloStatus othello_sized_make_move(OthelloSizedPosition* position, int move) {
+    uint64_t moves[2];
+    uint64_t flips[2];
+    int squares = position->size * position->size;
+    if (move >= squares || move < OTHELLO_PASS ||
+        !sized_moves(position, move == OTHELLO_PASS ? -1 : move, moves, flips)) {
+        return OTHELLO_ERROR_ILLEGAL_MOVE;
+    }
+
+    if (move == OTHELLO_PASS) {
+        if (moves[0] | moves[1]) {
+            return OTHELLO_ERROR_ILLEGAL_MOVE;
+        }
+    } else {
+        if (!((moves[move / 64] >> (move % 64)) & 1ULL)) {
+            return OTHELLO_ERROR_ILLEGAL_MOVE;
+        }
+        for (int word = 0; word < 2; word++) {
+            position->player[word] |= flips[word];
+            position->opponent[word] &= ~flips[word];
+        }
+        position->player[move / 64] |= 1ULL << (move % 64);
+    }
+
+    for (int word = 0; word < 2; word++) {
+        uint64_t player = position->player[word];
+        position->player[word] = position->opponent[word];
+        position->opponent[word] = player;
+    }
+    return OTHELLO_OK;
+}
+
+// Runs one size's root search, with a fresh table sized by the empty squares
+// when solving exactly. An exact solve without the table is still correct,
+// only slower.
+#define SIZED_RUN(fn, player_board, opponent_board)                                                          \
+    do {                                                                                                     \
+        fn##_table table = {NULL, (1ULL << table_bits) - 1};                                                 \
+        LargeBlock block = {NULL};                                                                           \
+        if (depth < 0 && empties >= SIZED_TABLE_MIN_EMPTIES &&                                               \
+            large_alloc(&block, ((size_t)table.mask + 1) * sizeof(fn##_entry), LARGE_ALLOC_HUGE_PAGES)) {    \
+            table.entries = (fn##_entry*)block.memory;                                                       \
+        }                                                                                                    \
+        result->score = fn##_search_root(table.entries ? &table : NULL, player_board, opponent_board, depth, \
+                                         &result->best_move, &result->nodes);                                \
+        large_free(&block);                                                                                  \
+    } while (0)
+
+static OthelloStatus sized_search(const OthelloSizedPosition* position, int depth, OthelloSearchResult* result) {
+    const uint64_t* p = position->player;
+    const uint64_t* o = position->opponent;
+    memset(result, 0, sizeof(*result));
+
+    int empties = position->size * position->size;
+    for (int word = 0; word < 2; word++) {
+        empties -= popcount64(p[word] | o[word]);
+    }
+    int table_bits = empties < SIZED_TABLE_MIN_BITS ? SIZED_TABLE_MIN_BITS
+                                                    : (empties > SIZED_TABLE_MAX_BITS ? SIZED_TABLE_MAX_BITS : empties);
+
+    switch (position->size) {
+        case 4:
+            SIZED_RUN(board4, (uint16_t)p[0], (uint16_t)o[0]);
+            break;
+        case 6:
+            SIZED_RUN(board6, p[0], o[0]);
+            break;
+        case 8:
+            SIZED_RUN(board8, p[0], o[0]);
+            break;
+#if OTHELLO_HAVE_BOARD10
+        case 10:
+            SIZED_RUN(board10, to_mask128(p), to_mask128(o));
+            break;
+#endif
+        default:
+            return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    result->depth = depth;
+    return OTHELLO_OK;
+}
+
+OTHELLO_API OthelloStatus othello_sized_solve(const OthelloSizedPosition* position, OthelloSearchResult* result) {
+    OthelloStatus status = sized_search(position, -1, result);
+    result->depth = position->size * position->size;
+    for (int word = 0; word < 2; word++) {
+        result->depth -= popcount64(position->player[word] | position->opponent[word]);
+    }
+    return status;
+}
+
+OTHELLO_API OthelloStatus othello_sized_search(const OthelloSizedPosition* position, int depth, OthelloSearchResult* result) {
+    if (depth < 1) {
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+    return sized_search(position, depth, result);
+}
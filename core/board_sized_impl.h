@@ -0,0 +1,274 @@
+// core/board_sized_impl.h
+//
+// Board kernels for one board size. board_sized.c includes this file once per
+// size with these defined:
+//
+//   SIZED_N              board width
+//   SIZED_T              unsigned mask type with at least SIZED_N * SIZED_N bits
+//   SIZED_FN(name)       name of the generated function
+//   SIZED_POPCOUNT(x)    number of set bits of a SIZED_T
+//   SIZED_LOWEST(x)      index of the lowest set bit of a non-zero SIZED_T
+//   SIZED_HASH(p, o)     64-bit hash of a position
+//
+// Squares are bits row * SIZED_N + col. Everything above the last square is
+// kept clear, so shifts never have to worry about the unused high bits.
+
+#define SQUARES (SIZED_N * SIZED_N)
+#define FULL ((SIZED_T)((SIZED_T)~(SIZED_T)0 >> (sizeof(SIZED_T) * 8 - SQUARES)))
+// FULL / (2^N - 1) sums 2^(row * N) over all rows: the first column.
+#define FIRST_COLUMN ((SIZED_T)(FULL / (((SIZED_T)1 << SIZED_N) - 1)))
+#define INNER_COLUMNS ((SIZED_T)(FULL & ~FIRST_COLUMN & ~(FIRST_COLUMN << (SIZED_N - 1))))
+#define CORNERS ((SIZED_T)(((SIZED_T)1 | ((SIZED_T)1 << (SIZED_N - 1))) * ((SIZED_T)1 | ((SIZED_T)1 << (SQUARES - SIZED_N)))))
+#define BIT(square) ((SIZED_T)1 << (square))
+
+// Runs of opponent discs are at most N - 2 long: one step plus N - 3 more.
+#define RUN_STEPS (SIZED_N - 3)
+
+static SIZED_T SIZED_FN(moves)(SIZED_T player_board, SIZED_T opponent_board) {
+    static const int shifts[4] = {1, SIZED_N, SIZED_N - 1, SIZED_N + 1};
+    SIZED_T empty = ~(player_board | opponent_board) & FULL;
+    SIZED_T moves = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int shift = shifts[i];
+        SIZED_T mask = opponent_board & (i == 1 ? FULL : INNER_COLUMNS);
+
+        SIZED_T left = mask & (player_board << shift);
+        SIZED_T right = mask & (player_board >> shift);
+        for (int j = 0; j < RUN_STEPS; j++) {
+            left |= mask & (left << shift);
+            right |= mask & (right >> shift);
+        }
+        moves |= (left << shift) | (right >> shift);
+    }
+
+    return moves & empty;
+}
+
+static SIZED_T SIZED_FN(flips)(int move, SIZED_T player_board, SIZED_T opponent_board) {
+    static const int shifts[4] = {1, SIZED_N, SIZED_N - 1, SIZED_N + 1};
+    SIZED_T move_bit = BIT(move);
+    SIZED_T flips = 0;
+
+    for (int i = 0; i < 4; i++) {
+        int shift = shifts[i];
+        SIZED_T mask = opponent_board & (i == 1 ? FULL : INNER_COLUMNS);
+
+        SIZED_T left = mask & (move_bit << shift);
+        SIZED_T right = mask & (move_bit >> shift);
+        for (int j = 0; j < RUN_STEPS; j++) {
+            left |= mask & (left << shift);
+            right |= mask & (right >> shift);
+        }
+        if ((left << shift) & player_board) {
+            flips |= left;
+        }
+        if ((right >> shift) & player_board) {
+            flips |= right;
+        }
+    }
+
+    return flips;
+}
+
+// Transposition table of the exact solver: bounds on the final score of a
+// position and the move that produced them.
+typedef struct {
+    SIZED_T player_board;
+    SIZED_T opponent_board;
+    signed char lower;
+    signed char upper;
+    signed char best_move;
+} SIZED_FN(entry);
+
+typedef struct {
+    SIZED_FN(entry)* entries;
+    uint64_t mask;
+} SIZED_FN(table);
+
+static int SIZED_FN(final_score)(SIZED_T player_board, SIZED_T opponent_board) {
+    int player_count = SIZED_POPCOUNT(player_board);
+    int opponent_count = SIZED_POPCOUNT(opponent_board);
+    int empties = SQUARES - player_count - opponent_count;
+    int diff = player_count - opponent_count;
+
+    if (diff > 0) {
+        return diff + empties;
+    } else if (diff < 0) {
+        return diff - empties;
+    }
+    return 0;
+}
+
+// Fastest-first ordering as in endgame.c: fewest opponent replies, then
+// corners. first, when a legal move, goes ahead of everything.
+static int SIZED_FN(order_moves)(SIZED_T moves, SIZED_T player_board, SIZED_T opponent_board, int first, int* ordered) {
+    int keys[SQUARES];
+    int count = 0;
+
+    if (first >= 0 && (moves & BIT(first))) {
+        moves &= ~BIT(first);
+        keys[count] = -1;
+        ordered[count++] = first;
+    }
+
+    while (moves) {
+        int move = SIZED_LOWEST(moves);
+        moves &= moves - 1;
+
+        SIZED_T flips = SIZED_FN(flips)(move, player_board, opponent_board);
+        SIZED_T new_player_board = player_board | flips | BIT(move);
+        SIZED_T new_opponent_board = opponent_board & ~flips;
+        int key = SIZED_POPCOUNT(SIZED_FN(moves)(new_opponent_board, new_player_board)) * 2;
+        if (!(BIT(move) & CORNERS)) {
+            key++;
+        }
+
+        int i = count++;
+        while (i > 0 && keys[i - 1] > key) {
+            keys[i] = keys[i - 1];
+            ordered[i] = ordered[i - 1];
+            i--;
+        }
+        keys[i] = key;
+        ordered[i] = move;
+    }
+
+    return count;
+}
+
+// Negamax over the final disc difference (depth < 0), or over a mobility
+// and corner heuristic once depth runs out. Terminal positions outscore any
+// heuristic value so the depth-limited search still prefers a certain win.
+// The table, when given, is only used when solving exactly.
+static int SIZED_FN(negamax)(SIZED_FN(table)* table, SIZED_T player_board, SIZED_T opponent_board, int depth, int alpha,
+                             int beta, bool passed, uint64_t* nodes) {
+    (*nodes)++;
+
+    SIZED_T moves = SIZED_FN(moves)(player_board, opponent_board);
+    if (moves == 0) {
+        if (passed) {
+            int score = SIZED_FN(final_score)(player_board, opponent_board);
+            return depth < 0 ? score : score * SIZED_TERMINAL_SCALE;
+        }
+        return -SIZED_FN(negamax)(table, opponent_board, player_board, depth, -beta, -alpha, true, nodes);
+    }
+
+    if (depth == 0) {
+        SIZED_T opponent_moves = SIZED_FN(moves)(opponent_board, player_board);
+        return SIZED_POPCOUNT(moves) - SIZED_POPCOUNT(opponent_moves) +
+               4 * (SIZED_POPCOUNT(player_board & CORNERS) - SIZED_POPCOUNT(opponent_board & CORNERS));
+    }
+
+    int empties = SQUARES - SIZED_POPCOUNT(player_board | opponent_board);
+    SIZED_FN(entry)* entry = NULL;
+    int first = -1;
+    if (table != NULL && depth < 0 && empties >= SIZED_TABLE_MIN_EMPTIES) {
+        entry = &table->entries[SIZED_HASH(player_board, opponent_board) & table->mask];
+        if (entry->player_board == player_board && entry->opponent_board == opponent_board) {
+            if (entry->lower >= beta || entry->lower == entry->upper) {
+                return entry->lower;
+            }
+            if (entry->upper <= alpha) {
+                return entry->upper;
+            }
+            if (entry->lower > alpha) {
+                alpha = entry->lower;
+            }
+            if (entry->upper < beta) {
+                beta = entry->upper;
+            }
+            first = entry->best_move;
+        }
+    }
+    int original_alpha = alpha;
+    int original_beta = beta;
+
+    int ordered[SQUARES];
+    int count;
+    if (empties >= 7) {
+        count = SIZED_FN(order_moves)(moves, player_board, opponent_board, first, ordered);
+    } else {
+        count = 0;
+        while (moves) {
+            ordered[count++] = SIZED_LOWEST(moves);
+            moves &= moves - 1;
+        }
+    }
+
+    int best_score = INT_MIN + 1;
+    int best_move = ordered[0];
+    for (int i = 0; i < count; i++) {
+        int move = ordered[i];
+        SIZED_T flips = SIZED_FN(flips)(move, player_board, opponent_board);
+        SIZED_T new_player_board = player_board | flips | BIT(move);
+        SIZED_T new_opponent_board = opponent_board & ~flips;
+
+        int score;
+        if (i == 0 || beta - alpha == 1) {
+            score = -SIZED_FN(negamax)(table, new_opponent_board, new_player_board, depth - 1, -beta, -alpha, false, nodes);
+        } else {
+            // Principal variation search: prove the later moves worse with a
+            // null window and only search a refutation with the full one.
+            score = -SIZED_FN(negamax)(table, new_opponent_board, new_player_board, depth - 1, -alpha - 1, -alpha, false, nodes);
+            if (score > alpha && score < beta) {
+                score = -SIZED_FN(negamax)(table, new_opponent_board, new_player_board, depth - 1, -beta, -score, false, nodes);
+            }
+        }
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (entry != NULL) {
+        // Fail-soft: a score outside the window is only a bound.
+        entry->player_board = player_board;
+        entry->opponent_board = opponent_board;
+        entry->lower = (signed char)(best_score > original_alpha ? best_score : -SQUARES);
+        entry->upper = (signed char)(best_score < original_beta ? best_score : SQUARES);
+        entry->best_move = (signed char)best_move;
+    }
+
+    return best_score;
+}
+
+// depth < 0 solves exactly. best_move is -1 when the side to move has to pass.
+static int SIZED_FN(search_root)(SIZED_FN(table)* table, SIZED_T player_board, SIZED_T opponent_board, int depth,
+                                 int* best_move, uint64_t* nodes) {
+    SIZED_T moves = SIZED_FN(moves)(player_board, opponent_board);
+    *best_move = -1;
+    if (moves == 0) {
+        return SIZED_FN(negamax)(table, player_board, opponent_board, depth, -SIZED_INFINITY, SIZED_INFINITY, false, nodes);
+    }
+
+    int ordered[SQUARES];
+    int count = SIZED_FN(order_moves)(moves, player_board, opponent_board, -1, ordered);
+    int alpha = -SIZED_INFINITY;
+    for (int i = 0; i < count; i++) {
+        int move = ordered[i];
+        SIZED_T flips = SIZED_FN(flips)(move, player_board, opponent_board);
+        int score = -SIZED_FN(negamax)(table, opponent_board & ~flips, player_board | flips | BIT(move),
+                                       depth < 0 ? depth : depth - 1, -SIZED_INFINITY, -alpha, false, nodes);
+        if (score > alpha || *best_move < 0) {
+            alpha = score;
+            *best_move = move;
+        }
+    }
+
+    return alpha;
+}
+
+#undef SQUARES
+#undef FULL
+#undef FIRST_COLUMN
+#undef INNER_COLUMNS
+#undef CORNERS
+#undef BIT
+#undef RUN_STEPS
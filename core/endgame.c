@@ -0,0 +1,155 @@
+// core/endgame.c
+
+#include "endgame.h"
+#include "board.h"
+
+#define CORNER_MASK 0x8100000000000081ULL
+// Below this many empties ordering costs more than it saves.
+#define ORDERING_MIN_EMPTIES 7
+
+static int final_score(uint64_t player_board, uint64_t opponent_board) {
+    int player_count = popcount64(player_board);
+    int opponent_count = popcount64(opponent_board);
+    int empties = 64 - player_count - opponent_count;
+    int diff = player_count - opponent_count;
+
+    if (diff > 0) {
+        return diff + empties;
+    } else if (diff < 0) {
+        return diff - empties;
+    }
+    return 0;
+}
+
+static inline int lowest_bit(uint64_t x) {
+    return popcount64((x & (~x + 1)) - 1);
+}
+
+// Fastest-first: replies that leave the opponent the fewest moves come first,
+// corners break ties.
+static int order_moves(uint64_t moves, uint64_t player_board, uint64_t opponent_board, int* ordered) {
+    int keys[64];
+    int count = 0;
+
+    while (moves) {
+        int move = lowest_bit(moves);
+        moves &= moves - 1;
+
+        uint64_t flips = get_flip_mask(move, player_board, opponent_board);
+        uint64_t new_player_board = player_board | flips | (1ULL << move);
+        uint64_t new_opponent_board = opponent_board & ~flips;
+        int key = popcount64(get_moves_mask(new_opponent_board, new_player_board)) * 2;
+        if (!((1ULL << move) & CORNER_MASK)) {
+            key++;
+        }
+
+        int i = count++;
+        while (i > 0 && keys[i - 1] > key) {
+            keys[i] = keys[i - 1];
+            ordered[i] = ordered[i - 1];
+            i--;
+        }
+        keys[i] = key;
+        ordered[i] = move;
+    }
+
+    return count;
+}
+
+static int solve(SearchContext* self, uint64_t player_board, uint64_t opponent_board, int alpha, int beta, bool passed) {
+    self->iter++;
+
+    if ((self->iter & SEARCH_STOP_CHECK_MASK) == 0 && search_should_stop(self)) {
+        self->aborted = true;
+    }
+    if (self->aborted) {
+        return 0;
+    }
+
+    uint64_t moves = get_moves_mask(player_board, opponent_board);
+    if (moves == 0) {
+        if (passed) {
+            return final_score(player_board, opponent_board);
+        }
+        return -solve(self, opponent_board, player_board, -beta, -alpha, true);
+    }
+
+    // Stability cutoff: the opponent keeps at least its stable discs, which
+    // caps our score. Only worth computing when its disc count alone allows a cut.
+    if (alpha >= 64 - 2 * popcount64(opponent_board)) {
+        int upper = 64 - 2 * popcount64(get_stable_discs(opponent_board, player_board));
+        if (upper <= alpha) {
+            return upper;
+        }
+    }
+
+    int ordered[64];
+    int count;
+    if (64 - popcount64(player_board | opponent_board) >= ORDERING_MIN_EMPTIES) {
+        count = order_moves(moves, player_board, opponent_board, ordered);
+    } else {
+        count = 0;
+        while (moves) {
+            ordered[count++] = lowest_bit(moves);
+            moves &= moves - 1;
+        }
+    }
+
+    int best_score = -65;
+    for (int i = 0; i < count; i++) {
+        int move = ordered[i];
+        uint64_t flips = get_flip_mask(move, player_board, opponent_board);
+        uint64_t new_player_board = player_board | flips | (1ULL << move);
+        uint64_t new_opponent_board = opponent_board & ~flips;
+
+        int score = -solve(self, new_opponent_board, new_player_board, -beta, -alpha, false);
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+
+    return best_score;
+}
+
+int endgame_solve(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, int alpha, int beta) {
+    return solve(ctx, player_board, opponent_board, alpha, beta, false);
+}
+
+int endgame_solve_root(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, int* best_move) {
+    uint64_t moves = get_moves_mask(player_board, opponent_board);
+    *best_move = -1;
+    if (moves == 0) {
+        return solve(ctx, player_board, opponent_board, -64, 64, false);
+    }
+
+    int ordered[64];
+    int count = order_moves(moves, player_board, opponent_board, ordered);
+    int best_score = -65;
+    for (int i = 0; i < count && !ctx->aborted; i++) {
+        int move = ordered[i];
+        uint64_t flips = get_flip_mask(move, player_board, opponent_board);
+        uint64_t new_player_board = player_board | flips | (1ULL << move);
+        uint64_t new_opponent_board = opponent_board & ~flips;
+
+        int score;
+        if (i == 0) {
+            score = -solve(ctx, new_opponent_board, new_player_board, -64, 64, false);
+        } else {
+            score = -solve(ctx, new_opponent_board, new_player_board, -best_score - 1, -best_score, false);
+            if (score > best_score) {
+                score = -solve(ctx, new_opponent_board, new_player_board, -64, -score + 1, false);
+            }
+        }
+        if (score > best_score && !ctx->aborted) {
+            best_score = score;
+            *best_move = move;
+        }
+    }
+    return best_score;
+}
@@ -0,0 +1,18 @@
+// core/endgame.h
+
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "search.h"
+
+// Exact final disc difference for the side to move under perfect play, with
+// empty squares credited to the winner. Fail-soft alpha-beta over the rest of
+// the game; counts nodes in ctx->iter and honours the context's stop checks.
+int endgame_solve(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, int alpha, int beta);
+
+// Exact score and a best move (-1 for a pass) of the position. Moves after the
+// first are tried with a null window around the best score so far and only
+// re-searched when they beat it.
+int endgame_solve_root(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, int* best_move);
+
+#endif /* ENDGAME_H */
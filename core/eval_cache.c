@@ -0,0 +1,34 @@
+// core/eval_cache.c
+
+#include "eval_cache.h"
+#include <stdlib.h>
+
+EvalCache* eval_cache_create(size_t size_mb) {
+    uint64_t entries = ((uint64_t)size_mb << 20) / sizeof(EvalCacheEntry);
+    if (entries == 0) {
+        return NULL;
+    }
+    while (entries & (entries - 1)) {
+        entries &= entries - 1;
+    }
+
+    EvalCache* cache = (EvalCache*)calloc(1, sizeof(EvalCache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    if (!large_alloc(&cache->block, (size_t)entries * sizeof(EvalCacheEntry), LARGE_ALLOC_HUGE_PAGES)) {
+        free(cache);
+        return NULL;
+    }
+    cache->entries = (EvalCacheEntry*)cache->block.memory;
+    cache->mask = entries - 1;
+    return cache;
+}
+
+void eval_cache_free(EvalCache* cache) {
+    if (cache == NULL) {
+        return;
+    }
+    large_free(&cache->block);
+    free(cache);
+}
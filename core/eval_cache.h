@@ -0,0 +1,62 @@
+// core/eval_cache.h
+
+#ifndef EVAL_CACHE_H
+#define EVAL_CACHE_H
+
+#include "large_alloc.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Direct-mapped cache of leaf scores, owned by one search context and kept
+// across its searches; a new position simply replaces the one in its slot.
+// Entries are 16 bytes so four share a cache line: the player's discs are kept
+// whole and the opponent's as an odd 32-bit check, which an empty slot never
+// matches.
+typedef struct {
+    uint64_t player_board;
+    uint32_t opponent_check;
+    int32_t score;
+} EvalCacheEntry;
+
+typedef struct {
+    EvalCacheEntry* entries;
+    uint64_t mask;
+    LargeBlock block;
+    uint64_t hits;
+    uint64_t misses;
+} EvalCache;
+
+// A cache of size_mb megabytes, rounded down to a power of two entries, or
+// NULL when out of memory. It asks for huge pages and is left to first touch,
+// which puts it on the node of the thread searching with it.
+EvalCache* eval_cache_create(size_t size_mb);
+void eval_cache_free(EvalCache* cache);
+
+static inline uint32_t eval_cache_check(uint64_t opponent_board) {
+    return (uint32_t)((opponent_board * 0xC2B2AE3D27D4EB4FULL) >> 32) | 1;
+}
+
+static inline EvalCacheEntry* eval_cache_entry(EvalCache* cache, uint64_t player_board, uint64_t opponent_board) {
+    uint64_t h = (player_board ^ (opponent_board * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL;
+    return &cache->entries[(h ^ (h >> 32)) & cache->mask];
+}
+
+// Counts the lookup towards the hit rate.
+static inline bool eval_cache_hit(EvalCache* cache, const EvalCacheEntry* entry, uint64_t player_board, uint64_t opponent_board) {
+    bool hit = entry->player_board == player_board && entry->opponent_check == eval_cache_check(opponent_board);
+    if (hit) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    return hit;
+}
+
+static inline void eval_cache_fill(EvalCacheEntry* entry, uint64_t player_board, uint64_t opponent_board, int score) {
+    entry->player_board = player_board;
+    entry->opponent_check = eval_cache_check(opponent_board);
+    entry->score = score;
+}
+
+#endif /* EVAL_CACHE_H */
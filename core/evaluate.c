@@ -0,0 +1,491 @@
+// core/evaluate.c
+
+#include "evaluate.h"
+#include "board.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdbool.h>
+#include <string.h>
+
+static int win_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int material_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int mobility_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int positional_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int corner_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int edge_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int frontier_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int parity_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int stability_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int random_evaluate(uint64_t player_board, uint64_t opponent_board);
+static int combined_evaluate(uint64_t player_board, uint64_t opponent_board);
+
+// Runs at every node of the search, so it uses the move masks rather than
+// building move lists.
+bool is_terminal_state(uint64_t player_board, uint64_t opponent_board) {
+    return get_moves_mask(player_board, opponent_board) == 0 && get_moves_mask(opponent_board, player_board) == 0;
+}
+
+void update_accumulator(SearchContext* self, int ply, int move, uint64_t player_board, uint64_t new_player_board) {
+    if (!self->nnue) {
+        return;
+    }
+    if (move < 0) {
+        self->nnue_stack[ply + 1] = self->nnue_stack[ply];
+        return;
+    }
+    uint64_t flips = (new_player_board ^ player_board) & ~(1ULL << move);
+    nnue_update(self->nnue, &self->nnue_stack[ply], &self->nnue_stack[ply + 1], ply & 1, move, flips);
+}
+
+static int win_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int player_count = popcount64(player_board);
+    int opponent_count = popcount64(opponent_board);
+    bool is_over = is_terminal_state(player_board, opponent_board);
+
+    if (is_over) {
+        if (player_count > opponent_count) {
+            return INT_MAX;
+        } else if (player_count < opponent_count) {
+            return INT_MIN + 1;
+        }
+    }
+
+    return 0;
+}
+
+static int material_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int player_count = popcount64(player_board);
+    int opponent_count = popcount64(opponent_board);
+    
+    return player_count - opponent_count;
+}
+
+static int mobility_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    MoveList player_moves;
+    MoveList opponent_moves;
+    get_valid_moves(player_board, opponent_board, &player_moves);
+    get_valid_moves(opponent_board, player_board, &opponent_moves);
+
+    int player_mobility = player_moves.count;
+    int opponent_mobility = opponent_moves.count;
+    
+    return player_mobility - opponent_mobility;
+}
+
+#define POSITION_VALUES_INIT { \
+    100, -50, 2, 2, 2, 2, -50, 100, \
+    -50, -100, 1, 1, 1, 1, -100, -50, \
+    2, 1, 0, 0, 0, 0, 1, 2, \
+    2, 1, 0, 0, 0, 0, 1, 2, \
+    2, 1, 0, 0, 0, 0, 1, 2, \
+    2, 1, 0, 0, 0, 0, 1, 2, \
+    -50, -100, 1, 1, 1, 1, -100, -50, \
+    100, -50, 2, 2, 2, 2, -50, 100 \
+}
+
+static const int POSITION_VALUES[64] = POSITION_VALUES_INIT;
+
+static int positional_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int score = 0;
+
+    for (int i = 0; i < 64; i++) {
+        if (player_board & (1ULL << i)) {
+            score += POSITION_VALUES[i];
+        } else if (opponent_board & (1ULL << i)) {
+            score -= POSITION_VALUES[i];
+        }
+    }
+
+    return score;
+}
+
+static const int CORNER_SQUARES[4] = {0, 7, 56, 63};
+
+static int corner_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int score = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t mask = 1ULL << CORNER_SQUARES[i];
+        if (player_board & mask) {
+            score += 1;
+        } else if (opponent_board & mask) {
+            score -= 1;
+        }
+    }
+
+    return score;
+}
+
+static const int EDGE_SQUARES[24] = {
+    1, 2, 3, 4, 5, 6,
+    8, 16, 24, 32, 40, 48,
+    55, 54, 53, 52, 51, 50,
+    57, 58, 59, 60, 61, 62
+};
+
+static int edge_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int score = 0;
+
+    for (int i = 0; i < 24; i++) {
+        uint64_t mask = 1ULL << EDGE_SQUARES[i];
+        if (player_board & mask) {
+            score += 1;
+        } else if (opponent_board & mask) {
+            score -= 1;
+        }
+    }
+
+    return score;
+}
+
+static int frontier_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    uint64_t empty = ~(player_board | opponent_board);
+
+    uint64_t adjacent_to_empty = 0;
+    adjacent_to_empty |= empty << 8; // North
+    adjacent_to_empty |= empty >> 8; // South
+    adjacent_to_empty |= (empty & 0xFEFEFEFEFEFEFEFEULL) << 1;  // East
+    adjacent_to_empty |= (empty & 0x7F7F7F7F7F7F7F7FULL) >> 1;  // West
+    adjacent_to_empty |= (empty & 0xFEFEFEFEFEFEFEFEULL) << 9;  // Northeast
+    adjacent_to_empty |= (empty & 0x7F7F7F7F7F7F7F7FULL) << 7;  // Northwest
+    adjacent_to_empty |= (empty & 0xFEFEFEFEFEFEFEFEULL) >> 7;  // Southeast
+    adjacent_to_empty |= (empty & 0x7F7F7F7F7F7F7F7FULL) >> 9;  // Southwest
+
+    int player_frontier = popcount64(player_board & adjacent_to_empty);
+    int opponent_frontier = popcount64(opponent_board & adjacent_to_empty);
+
+    return player_frontier - opponent_frontier;
+}
+
+static int parity_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int empty_squares = popcount64(~(player_board | opponent_board));
+
+    if (empty_squares % 2 == 0) {
+        return 1;
+    } else {
+        return -1;
+    }
+}
+
+static int stability_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    int player_stable = popcount64(get_stable_discs(player_board, opponent_board));
+    int opponent_stable = popcount64(get_stable_discs(opponent_board, player_board));
+
+    return player_stable - opponent_stable;
+}
+
+static const char* EVAL_TERM_NAMES[EVAL_TERM_COUNT] = {
+    "win_evaluate", "material_evaluate", "mobility_evaluate", "positional_evaluate", "corner_evaluate",
+    "edge_evaluate", "frontier_evaluate", "parity_evaluate", "stability_evaluate",
+};
+
+// CORNER_SQUARES and EDGE_SQUARES as masks.
+#define CORNER_MASK 0x8100000000000081ULL
+#define EDGE_MASK 0x7EFD01010101017EULL
+
+static int find_eval_term(const char* name) {
+    int term = 0;
+    while (term < EVAL_TERM_COUNT && strcmp(name, EVAL_TERM_NAMES[term]) != 0) {
+        term++;
+    }
+    return term;
+}
+
+OthelloStatus composed_evaluator_init(ComposedEvaluator* composer, const OthelloEvalTerm* terms, int count, char* error,
+                                      size_t error_size) {
+    memset(composer, 0, sizeof(*composer));
+    composer->phase_limits[0] = 15;
+    composer->phase_limits[1] = 45;
+    memcpy(composer->position_values, POSITION_VALUES, sizeof(POSITION_VALUES));
+    for (int i = 0; i < count; i++) {
+        int term = find_eval_term(terms[i].term);
+        if (term == EVAL_TERM_COUNT) {
+            if (find_eval_func(terms[i].term) != NULL || strcmp(terms[i].term, "nnue_evaluate") == 0) {
+                snprintf(error, error_size, "%s cannot be composed.", terms[i].term);
+            } else {
+                snprintf(error, error_size, "Unknown evaluation term: '%s'", terms[i].term);
+            }
+            return OTHELLO_ERROR_UNKNOWN_EVALUATOR;
+        }
+        for (int phase = 0; phase < OTHELLO_EVAL_PHASES; phase++) {
+            composer->weights[phase][term] += terms[i].weights[phase];
+        }
+    }
+    return OTHELLO_OK;
+}
+
+static inline int position_sum(const int* position_values, uint64_t board) {
+    int score = 0;
+    while (board) {
+        int square = popcount64((board & (~board + 1)) - 1);
+        board &= board - 1;
+        score += position_values[square];
+    }
+    return score;
+}
+
+// Inlined into combined_evaluate, where the weights are constants and the
+// unused branches fold away.
+static inline int fused_evaluate(const ComposedEvaluator* composer, uint64_t player_board, uint64_t opponent_board) {
+    int player_count = popcount64(player_board);
+    int opponent_count = popcount64(opponent_board);
+    int discs = player_count + opponent_count;
+    const int* weights = composer->weights[discs <= composer->phase_limits[0] ? 0 : (discs <= composer->phase_limits[1] ? 1 : 2)];
+
+    uint64_t player_moves = 0;
+    uint64_t opponent_moves = 0;
+    if (weights[EVAL_TERM_WIN] || weights[EVAL_TERM_MOBILITY]) {
+        player_moves = get_moves_mask(player_board, opponent_board);
+        opponent_moves = get_moves_mask(opponent_board, player_board);
+    }
+
+    if (weights[EVAL_TERM_WIN] && player_moves == 0 && opponent_moves == 0) {
+        if (player_count > opponent_count) {
+            return INT_MAX;
+        } else if (player_count < opponent_count) {
+            return INT_MIN + 1;
+        }
+    }
+
+    int score = 0;
+    if (weights[EVAL_TERM_MATERIAL]) {
+        score += weights[EVAL_TERM_MATERIAL] * (player_count - opponent_count);
+    }
+    if (weights[EVAL_TERM_MOBILITY]) {
+        score += weights[EVAL_TERM_MOBILITY] * (popcount64(player_moves) - popcount64(opponent_moves));
+    }
+    if (weights[EVAL_TERM_POSITIONAL]) {
+        score += weights[EVAL_TERM_POSITIONAL] * (position_sum(composer->position_values, player_board) -
+                                                        position_sum(composer->position_values, opponent_board));
+    }
+    if (weights[EVAL_TERM_CORNER]) {
+        score += weights[EVAL_TERM_CORNER] * (popcount64(player_board & CORNER_MASK) - popcount64(opponent_board & CORNER_MASK));
+    }
+    if (weights[EVAL_TERM_EDGE]) {
+        score += weights[EVAL_TERM_EDGE] * (popcount64(player_board & EDGE_MASK) - popcount64(opponent_board & EDGE_MASK));
+    }
+    if (weights[EVAL_TERM_FRONTIER]) {
+        score += weights[EVAL_TERM_FRONTIER] * frontier_evaluate(player_board, opponent_board);
+    }
+    if (weights[EVAL_TERM_PARITY]) {
+        score += weights[EVAL_TERM_PARITY] * ((64 - discs) % 2 == 0 ? 1 : -1);
+    }
+    if (weights[EVAL_TERM_STABILITY]) {
+        score += weights[EVAL_TERM_STABILITY] * stability_evaluate(player_board, opponent_board);
+    }
+    return score;
+}
+
+int composed_evaluate(const ComposedEvaluator* composer, uint64_t player_board, uint64_t opponent_board) {
+    return fused_evaluate(composer, player_board, opponent_board);
+}
+
+// win_evaluate first, then the weights per phase.
+static const ComposedEvaluator COMBINED_WEIGHTS = {
+    {
+        // win, material, mobility, positional, corner, edge, frontier, parity, stability
+        {1, 1, 4, 4, 5, 4, 1, 1, 0},
+        {1, 3, 4, 4, 5, 4, 2, 1, 0},
+        {1, 4, 4, 4, 5, 4, 2, 2, 0},
+    },
+    {15, 45},
+    POSITION_VALUES_INIT,
+};
+
+static int combined_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    return fused_evaluate(&COMBINED_WEIGHTS, player_board, opponent_board);
+}
+
+void combined_evaluator_params(ComposedEvaluator* composer) {
+    *composer = COMBINED_WEIGHTS;
+}
+
+OthelloStatus composed_evaluator_load(ComposedEvaluator* composer, const char* path, char* error, size_t error_size) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        snprintf(error, error_size, "Cannot open evaluation parameters '%s'.", path);
+        return OTHELLO_ERROR_IO;
+    }
+    composed_evaluator_init(composer, NULL, 0, error, error_size);
+
+    char line[256];
+    if (fgets(line, sizeof(line), file) == NULL || strncmp(line, EVAL_PARAMS_MAGIC, strlen(EVAL_PARAMS_MAGIC)) != 0) {
+        snprintf(error, error_size, "'%s' is not an evaluation parameter file.", path);
+        fclose(file);
+        return OTHELLO_ERROR_IO;
+    }
+
+    // position_values is followed by 64 values, spread over any number of lines.
+    int squares = 64;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[strspn(line, " \t")] == '\0') {
+            continue;
+        }
+
+        char name[64];
+        int weights[OTHELLO_EVAL_PHASES];
+        int offset = 0;
+        bool valid;
+        if (squares < 64) {
+            int value;
+            const char* cursor = line;
+            valid = true;
+            while (valid && squares < 64 && sscanf(cursor, "%d%n", &value, &offset) == 1) {
+                composer->position_values[squares++] = value;
+                cursor += offset;
+            }
+            valid = cursor[strspn(cursor, " \t")] == '\0';
+        } else if (strcmp(line, "position_values") == 0) {
+            squares = 0;
+            valid = true;
+        } else if (sscanf(line, "phase_limits %d %d", &weights[0], &weights[1]) == 2) {
+            composer->phase_limits[0] = weights[0];
+            composer->phase_limits[1] = weights[1];
+            valid = weights[0] <= weights[1];
+        } else if (sscanf(line, "%63s %d %d %d", name, &weights[0], &weights[1], &weights[2]) == 4 &&
+                   find_eval_term(name) < EVAL_TERM_COUNT) {
+            for (int phase = 0; phase < OTHELLO_EVAL_PHASES; phase++) {
+                composer->weights[phase][find_eval_term(name)] = weights[phase];
+            }
+            valid = true;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            snprintf(error, error_size, "Malformed evaluation parameter line in '%s': %s", path, line);
+            fclose(file);
+            return OTHELLO_ERROR_IO;
+        }
+    }
+    fclose(file);
+
+    if (squares < 64) {
+        snprintf(error, error_size, "'%s' lists fewer than 64 position_values.", path);
+        return OTHELLO_ERROR_IO;
+    }
+    return OTHELLO_OK;
+}
+
+bool composed_evaluator_save(const ComposedEvaluator* composer, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    fprintf(file, "%s\n", EVAL_PARAMS_MAGIC);
+    fprintf(file, "phase_limits %d %d\n", composer->phase_limits[0], composer->phase_limits[1]);
+    fprintf(file, "# term opening midgame endgame\n");
+    for (int term = 0; term < EVAL_TERM_COUNT; term++) {
+        fprintf(file, "%s %d %d %d\n", EVAL_TERM_NAMES[term], composer->weights[0][term], composer->weights[1][term],
+                composer->weights[2][term]);
+    }
+    fprintf(file, "position_values\n");
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            fprintf(file, col < 7 ? "%d " : "%d\n", composer->position_values[row * 8 + col]);
+        }
+    }
+
+    return fclose(file) == 0;
+}
+
+
+static bool random_seeded = false;
+
+void seed_random_evaluate(unsigned int seed) {
+    srand(seed);
+    random_seeded = true;
+}
+
+static int random_evaluate(uint64_t player_board, uint64_t opponent_board) {
+    if (!random_seeded) {
+        srand((unsigned int)time(NULL));
+        random_seeded = true;
+    }
+    int min_value = -50;
+    int max_value = 50;
+    int range = max_value - min_value + 1;
+    int random_value = rand() % range + min_value;
+    return random_value;
+}
+
+#define SEARCH_EVALUATOR win_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR material_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR mobility_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR positional_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR corner_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR edge_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR frontier_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR parity_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR stability_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR combined_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR random_evaluate
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR nnue_evaluate
+#define SEARCH_NNUE 1
+#include "minimax_search.h"
+#define SEARCH_EVALUATOR composed_evaluate
+#define SEARCH_COMPOSED 1
+#include "minimax_search.h"
+
+typedef struct {
+    const char* name;
+    EvalFunc func;
+    const SearchFuncs* release;
+    const SearchFuncs* debug;
+} EvalFuncMapping;
+
+#define EVAL_FUNC_ENTRY(name) \
+    {#name, name, &search_funcs_##name##_release, &search_funcs_##name##_debug}
+
+static EvalFuncMapping eval_functions[] = {
+    EVAL_FUNC_ENTRY(win_evaluate),
+    EVAL_FUNC_ENTRY(material_evaluate),
+    EVAL_FUNC_ENTRY(mobility_evaluate),
+    EVAL_FUNC_ENTRY(positional_evaluate),
+    EVAL_FUNC_ENTRY(corner_evaluate),
+    EVAL_FUNC_ENTRY(edge_evaluate),
+    EVAL_FUNC_ENTRY(frontier_evaluate),
+    EVAL_FUNC_ENTRY(parity_evaluate),
+    EVAL_FUNC_ENTRY(stability_evaluate),
+    EVAL_FUNC_ENTRY(combined_evaluate),
+    EVAL_FUNC_ENTRY(random_evaluate),
+    {NULL, NULL, NULL, NULL}
+};
+
+EvalFunc find_eval_func(const char* name) {
+    for (int i = 0; eval_functions[i].name != NULL; i++) {
+        if (strcmp(name, eval_functions[i].name) == 0) {
+            return eval_functions[i].func;
+        }
+    }
+    return NULL;
+}
+
+const SearchFuncs* find_search_funcs(const char* name, bool debug) {
+    if (strcmp(name, "nnue_evaluate") == 0) {
+        return debug ? &search_funcs_nnue_evaluate_debug : &search_funcs_nnue_evaluate_release;
+    }
+    if (strcmp(name, "composed_evaluate") == 0) {
+        return debug ? &search_funcs_composed_evaluate_debug : &search_funcs_composed_evaluate_release;
+    }
+    for (int i = 0; eval_functions[i].name != NULL; i++) {
+        if (strcmp(name, eval_functions[i].name) == 0) {
+            return debug ? eval_functions[i].debug : eval_functions[i].release;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,68 @@
+// core/evaluate.h
+
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "search.h"
+
+// Terms of a composed evaluator, named after the evaluator each one matches.
+typedef enum {
+    EVAL_TERM_WIN,
+    EVAL_TERM_MATERIAL,
+    EVAL_TERM_MOBILITY,
+    EVAL_TERM_POSITIONAL,
+    EVAL_TERM_CORNER,
+    EVAL_TERM_EDGE,
+    EVAL_TERM_FRONTIER,
+    EVAL_TERM_PARITY,
+    EVAL_TERM_STABILITY,
+    EVAL_TERM_COUNT
+} EvalTerm;
+
+struct ComposedEvaluator {
+    int weights[OTHELLO_EVAL_PHASES][EVAL_TERM_COUNT];
+    // Most discs on the board for the opening and the midgame weights.
+    int phase_limits[OTHELLO_EVAL_PHASES - 1];
+    // positional_evaluate's value of each square.
+    int position_values[64];
+};
+
+#define EVAL_PARAMS_MAGIC "othello-eval 1"
+
+// Builds composer from terms; a term listed twice adds up. Phase limits and
+// square values are the built-in ones. Fails with error set on an unknown or
+// non-composable term.
+OthelloStatus composed_evaluator_init(ComposedEvaluator* composer, const OthelloEvalTerm* terms, int count, char* error,
+                                      size_t error_size);
+
+// The parameters of combined_evaluate.
+void combined_evaluator_params(ComposedEvaluator* composer);
+
+// Reads a parameter file as written by composed_evaluator_save. Terms it does
+// not list weigh zero; missing phase limits and square values keep the
+// built-in ones.
+OthelloStatus composed_evaluator_load(ComposedEvaluator* composer, const char* path, char* error, size_t error_size);
+bool composed_evaluator_save(const ComposedEvaluator* composer, const char* path);
+
+// The weighted sum of the composer's terms for the current phase. Move masks,
+// disc counts and the frontier are computed once and only when a term with a
+// non-zero weight needs them.
+int composed_evaluate(const ComposedEvaluator* composer, uint64_t player_board, uint64_t opponent_board);
+
+// Looks up an evaluator in eval_functions[] by name, NULL if unknown.
+EvalFunc find_eval_func(const char* name);
+
+// Looks up the search specialized for the named evaluator, NULL if unknown.
+const SearchFuncs* find_search_funcs(const char* name, bool debug);
+
+bool is_terminal_state(uint64_t player_board, uint64_t opponent_board);
+
+// Seeds the C library generator behind random_evaluate (and RandomPlayer),
+// replacing the time-based seed it would otherwise pick on first use.
+void seed_random_evaluate(unsigned int seed);
+
+// Keeps the NNUE accumulator stack in step with the search: the child ply is
+// derived from the parent with the placed disc and flip mask, and a pass just copies it.
+void update_accumulator(SearchContext* self, int ply, int move, uint64_t player_board, uint64_t new_player_board);
+
+#endif /* EVALUATE_H */
@@ -0,0 +1,227 @@
+// core/large_alloc.c
+
+#include "large_alloc.h"
+#include <string.h>
+
+const char* large_pages_name(LargePages pages) {
+    switch (pages) {
+        case LARGE_PAGES_TRANSPARENT:
+            return "transparent";
+        case LARGE_PAGES_EXPLICIT:
+            return "explicit";
+        default:
+            return "normal";
+    }
+}
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+// Large pages need the "Lock pages in memory" privilege; without it the
+// first VirtualAlloc fails and normal pages are used. Interleaving is left
+// to the system.
+bool large_alloc(LargeBlock* block, size_t size, int flags) {
+    memset(block, 0, sizeof(LargeBlock));
+    if (size == 0) {
+        return false;
+    }
+    SIZE_T large_page = GetLargePageMinimum();
+    if ((flags & LARGE_ALLOC_HUGE_PAGES) && large_page != 0 && size >= large_page) {
+        size_t rounded = (size + large_page - 1) / large_page * large_page;
+        block->memory = VirtualAlloc(NULL, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (block->memory != NULL) {
+            block->size = rounded;
+            block->pages = LARGE_PAGES_EXPLICIT;
+            return true;
+        }
+    }
+    block->memory = VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    block->size = size;
+    return block->memory != NULL;
+}
+
+void large_free(LargeBlock* block) {
+    if (block->memory != NULL) {
+        VirtualFree(block->memory, 0, MEM_RELEASE);
+    }
+    memset(block, 0, sizeof(LargeBlock));
+}
+
+int large_advise(void* memory, size_t size, int flags) {
+    return 0;
+}
+
+int large_alloc_node_count(void) {
+    return 1;
+}
+
+#else
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+#define MAX_NODES 1024
+// From <numaif.h>, which needs libnuma's headers.
+#define MPOL_INTERLEAVE_MODE 3
+
+static size_t round_up(size_t size, size_t unit) {
+    return (size + unit - 1) / unit * unit;
+}
+
+// Nodes listed in has_memory ("0", "0-1,3"), or 0 when it cannot be read.
+static int memory_nodes(unsigned long* mask) {
+    int count = 0;
+#ifdef __linux__
+    FILE* file = fopen("/sys/devices/system/node/has_memory", "r");
+    if (file == NULL) {
+        return 0;
+    }
+    int first, last;
+    while (fscanf(file, "%d", &first) == 1) {
+        last = first;
+        int separator = fgetc(file);
+        if (separator == '-') {
+            if (fscanf(file, "%d", &last) != 1) {
+                break;
+            }
+            separator = fgetc(file);
+        }
+        for (int node = first; node <= last && node >= 0 && node < MAX_NODES; node++) {
+            mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+            count++;
+        }
+        if (separator != ',') {
+            break;
+        }
+    }
+    fclose(file);
+#endif
+    return count;
+}
+
+int large_alloc_node_count(void) {
+    unsigned long mask[MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    int count = memory_nodes(mask);
+    return count > 0 ? count : 1;
+}
+
+static bool interleave(void* memory, size_t size) {
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long mask[MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    if (memory_nodes(mask) < 2) {
+        return false;
+    }
+    return syscall(SYS_mbind, memory, size, MPOL_INTERLEAVE_MODE, mask, (unsigned long)MAX_NODES + 1, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+// madvise accepts MADV_HUGEPAGE even when transparent huge pages are turned
+// off, so the system setting is checked as well.
+static bool transparent_huge_pages(void* memory, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    char setting[128] = "";
+    FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (file == NULL) {
+        return false;
+    }
+    bool enabled = fgets(setting, sizeof(setting), file) != NULL && strstr(setting, "[never]") == NULL;
+    fclose(file);
+    return enabled && madvise(memory, size, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+static void* map_anonymous(size_t size, int extra_flags) {
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+}
+
+// Maps one huge page more than needed and trims both ends, so the block
+// starts on a huge page boundary and every 2 MB of it can be one page.
+static void* map_huge_aligned(size_t size) {
+    char* raw = (char*)map_anonymous(size + HUGE_PAGE_SIZE, 0);
+    if (raw == NULL) {
+        return NULL;
+    }
+    char* aligned = (char*)round_up((uintptr_t)raw, HUGE_PAGE_SIZE);
+    if (aligned > raw) {
+        munmap(raw, (size_t)(aligned - raw));
+    }
+    size_t tail = (size_t)(raw + size + HUGE_PAGE_SIZE - (aligned + size));
+    if (tail > 0) {
+        munmap(aligned + size, tail);
+    }
+    return aligned;
+}
+
+bool large_alloc(LargeBlock* block, size_t size, int flags) {
+    memset(block, 0, sizeof(LargeBlock));
+    if (size == 0) {
+        return false;
+    }
+
+    if ((flags & LARGE_ALLOC_HUGE_PAGES) && size >= HUGE_PAGE_SIZE) {
+        size_t rounded = round_up(size, HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+        // Fails at once unless the reserved pool can hold the whole block.
+        block->memory = map_anonymous(rounded, MAP_HUGETLB);
+        if (block->memory != NULL) {
+            block->pages = LARGE_PAGES_EXPLICIT;
+        }
+#endif
+        if (block->memory == NULL) {
+            block->memory = map_huge_aligned(rounded);
+            if (block->memory != NULL && transparent_huge_pages(block->memory, rounded)) {
+                block->pages = LARGE_PAGES_TRANSPARENT;
+            }
+        }
+        block->size = rounded;
+    }
+    if (block->memory == NULL) {
+        block->memory = map_anonymous(size, 0);
+        block->size = size;
+        block->pages = LARGE_PAGES_NORMAL;
+    }
+    if (block->memory == NULL) {
+        memset(block, 0, sizeof(LargeBlock));
+        return false;
+    }
+
+    block->interleaved = (flags & LARGE_ALLOC_INTERLEAVE) && interleave(block->memory, block->size);
+    return true;
+}
+
+void large_free(LargeBlock* block) {
+    if (block->memory != NULL) {
+        munmap(block->memory, block->size);
+    }
+    memset(block, 0, sizeof(LargeBlock));
+}
+
+int large_advise(void* memory, size_t size, int flags) {
+    int applied = 0;
+    if ((flags & LARGE_ALLOC_HUGE_PAGES) && size >= HUGE_PAGE_SIZE && transparent_huge_pages(memory, size)) {
+        applied |= LARGE_ALLOC_HUGE_PAGES;
+    }
+    if ((flags & LARGE_ALLOC_INTERLEAVE) && interleave(memory, size)) {
+        applied |= LARGE_ALLOC_INTERLEAVE;
+    }
+    return applied;
+}
+
+#endif
@@ -0,0 +1,45 @@
+// core/large_alloc.h
+
+#ifndef LARGE_ALLOC_H
+#define LARGE_ALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Back the block with huge pages: an explicit pool (MAP_HUGETLB, Windows large
+// pages) when one is reserved, else transparent huge pages.
+#define LARGE_ALLOC_HUGE_PAGES 1
+// Spread the pages over all NUMA nodes, for memory probed from every socket.
+// Without it pages land on the node of the thread that first writes them.
+#define LARGE_ALLOC_INTERLEAVE 2
+
+typedef enum {
+    LARGE_PAGES_NORMAL,
+    LARGE_PAGES_TRANSPARENT,
+    LARGE_PAGES_EXPLICIT
+} LargePages;
+
+typedef struct {
+    void* memory;
+    size_t size;
+    LargePages pages;
+    bool interleaved;
+} LargeBlock;
+
+// Maps at least size zeroed bytes, aligned to the huge page size when asking
+// for huge pages. Each flag falls back silently when the system lacks it;
+// the block records what was granted. Returns false when out of memory.
+bool large_alloc(LargeBlock* block, size_t size, int flags);
+void large_free(LargeBlock* block);
+
+// Applies the flags to an existing mapping, such as a shared-memory segment,
+// before its pages are first touched. Explicit huge pages need a hugetlbfs
+// file and are not applied. Returns the flags that took effect.
+int large_advise(void* memory, size_t size, int flags);
+
+// NUMA nodes with memory, at least 1.
+int large_alloc_node_count(void);
+
+const char* large_pages_name(LargePages pages);
+
+#endif /* LARGE_ALLOC_H */
@@ -0,0 +1,54 @@
+// core/minimax_search.h
+//
+// Generates a minimax/minimax_abp pair specialized for one evaluator so the leaf
+// call is direct and can be inlined. Define SEARCH_EVALUATOR to the evaluator's
+// name (and SEARCH_NNUE to 1 for the incremental network, or SEARCH_COMPOSED
+// to 1 for the context's composed evaluator) before including;
+// this yields search_funcs_<evaluator>_release and search_funcs_<evaluator>_debug,
+// the latter keeping the periodic iteration printout.
+// No include guard on purpose.
+
+#ifndef SEARCH_NNUE
+#define SEARCH_NNUE 0
+#endif
+#ifndef SEARCH_COMPOSED
+#define SEARCH_COMPOSED 0
+#endif
+
+#if SEARCH_NNUE
+#define SEARCH_EVALUATE(self, player_board, opponent_board, ply) \
+    nnue_evaluate((self)->nnue, &(self)->nnue_stack[ply], (ply) & 1)
+#define SEARCH_UPDATE(self, ply, move, player_board, new_player_board) \
+    update_accumulator(self, ply, move, player_board, new_player_board)
+#elif SEARCH_COMPOSED
+#define SEARCH_EVALUATE(self, player_board, opponent_board, ply) \
+    ((void)(ply), SEARCH_EVALUATOR((self)->composer, player_board, opponent_board))
+#define SEARCH_UPDATE(self, ply, move, player_board, new_player_board) ((void)(ply))
+#else
+#define SEARCH_EVALUATE(self, player_board, opponent_board, ply) \
+    ((void)(ply), SEARCH_EVALUATOR(player_board, opponent_board))
+#define SEARCH_UPDATE(self, ply, move, player_board, new_player_board) ((void)(ply))
+#endif
+
+#define SEARCH_CONCAT_(a, b, c) a##_##b##_##c
+#define SEARCH_CONCAT(a, b, c) SEARCH_CONCAT_(a, b, c)
+
+#define SEARCH_DEBUG 0
+#define SEARCH_FN(name) SEARCH_CONCAT(name, SEARCH_EVALUATOR, release)
+#include "minimax_search_impl.h"
+#undef SEARCH_FN
+#undef SEARCH_DEBUG
+
+#define SEARCH_DEBUG 1
+#define SEARCH_FN(name) SEARCH_CONCAT(name, SEARCH_EVALUATOR, debug)
+#include "minimax_search_impl.h"
+#undef SEARCH_FN
+#undef SEARCH_DEBUG
+
+#undef SEARCH_EVALUATE
+#undef SEARCH_UPDATE
+#undef SEARCH_CONCAT
+#undef SEARCH_CONCAT_
+#undef SEARCH_NNUE
+#undef SEARCH_COMPOSED
+#undef SEARCH_EVALUATOR
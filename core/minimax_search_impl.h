@@ -0,0 +1,230 @@
+// core/minimax_search_impl.h
+//
+// Search body template, included by minimax_search.h once per debug setting.
+// No include guard on purpose.
+//
+// The search walks self->frames instead of recursing: entering a node fills
+// the next frame, and a finished node folds its value into the frame below.
+
+// Multi-ProbCut: null-window probes at a shallower depth decide whether the
+// deep score of frame's node would land outside its window. Returns true with
+// *score set to the violated bound when it would.
+static bool SEARCH_FN(probcut)(SearchContext* self, SearchFrame* frame, int* score);
+
+// Makes frame's line its current move followed by the line of the child above it.
+static void SEARCH_FN(update_pv)(SearchContext* self, SearchFrame* frame) {
+    int stride = self->depth_limit + 1;
+    signed char* line = self->pv + (frame - self->frames) * stride;
+    int length = frame[1].pv_length;
+    line[0] = frame->current_move;
+    memcpy(line + 1, line + stride, (size_t)length);
+    frame->pv_length = (signed char)(length + 1);
+}
+
+static int SEARCH_FN(run)(SearchContext* self, SearchFrame* root, bool prune) {
+    SearchFrame* frame = root;
+    int value;
+
+enter:
+    self->iter++;
+
+#if SEARCH_DEBUG
+    if (self->iter % 1000000 == 0) {
+        printf("Iteration: %llu\n", (unsigned long long)self->iter);
+    }
+#endif
+
+    if ((self->iter & SEARCH_STOP_CHECK_MASK) == 0 && search_should_stop(self)) {
+        self->aborted = true;
+    }
+    if (self->aborted) {
+        // Partial results are discarded, so unwind everything at once.
+        return 0;
+    }
+
+    {
+        int ply = self->max_depth - frame->depth;
+        frame->pv_length = 0;
+
+        if (frame->depth == 0 || is_terminal_state(frame->player_board, frame->opponent_board)) {
+            EvalCache* cache = self->eval_cache;
+            EvalCacheEntry* entry = cache ? eval_cache_entry(cache, frame->player_board, frame->opponent_board) : NULL;
+            if (entry != NULL && eval_cache_hit(cache, entry, frame->player_board, frame->opponent_board)) {
+                value = entry->score;
+            } else {
+                value = SEARCH_EVALUATE(self, frame->player_board, frame->opponent_board, ply);
+                if (entry != NULL) {
+                    eval_cache_fill(entry, frame->player_board, frame->opponent_board, value);
+                }
+            }
+            goto leave;
+        }
+
+        // Analysis keeps the table out of the way: a cutoff has no line to report.
+        if (prune && self->table != NULL && !self->track_pv) {
+            frame->original_alpha = frame->alpha;
+            frame->original_beta = frame->beta;
+            if (shared_table_probe(self->table, search_table_key(self, frame), frame->depth, frame->alpha, frame->beta, &value)) {
+                goto leave;
+            }
+        }
+
+        if (prune && self->mpc != NULL && !self->mpc_probing && frame->depth >= MPC_MIN_DEPTH && frame->depth <= MPC_MAX_DEPTH) {
+            if (SEARCH_FN(probcut)(self, frame, &value)) {
+                goto leave;
+            }
+        }
+
+        frame->moves = get_moves_mask(frame->player_board, frame->opponent_board);
+        frame->passing = frame->moves == 0;
+        frame->best_value = frame->maximizing ? INT_MIN : INT_MAX;
+
+        if (frame->passing) {
+            SearchFrame* child = frame + 1;
+            frame->current_move = OTHELLO_PASS;
+            SEARCH_UPDATE(self, ply, -1, frame->player_board, frame->player_board);
+            child->player_board = frame->opponent_board;
+            child->opponent_board = frame->player_board;
+            child->depth = frame->depth - 1;
+            child->alpha = frame->alpha;
+            child->beta = frame->beta;
+            child->maximizing = !frame->maximizing;
+            frame = child;
+            goto enter;
+        }
+    }
+
+next:
+    if (frame->moves == 0) {
+        value = frame->best_value;
+        if (prune && self->table != NULL && !self->track_pv) {
+            shared_table_store(self->table, search_table_key(self, frame), frame->depth, frame->original_alpha,
+                               frame->original_beta, value);
+        }
+        goto leave;
+    }
+
+    {
+        int ply = self->max_depth - frame->depth;
+        int move = popcount64((frame->moves & (~frame->moves + 1)) - 1);
+        frame->moves &= frame->moves - 1;
+        frame->current_move = (signed char)move;
+
+        uint64_t flips = get_flip_mask(move, frame->player_board, frame->opponent_board);
+        uint64_t new_player_board = frame->player_board | flips | (1ULL << move);
+
+        SearchFrame* child = frame + 1;
+        SEARCH_UPDATE(self, ply, move, frame->player_board, new_player_board);
+        child->player_board = frame->opponent_board & ~flips;
+        child->opponent_board = new_player_board;
+        child->depth = frame->depth - 1;
+        child->alpha = frame->alpha;
+        child->beta = frame->beta;
+        child->maximizing = !frame->maximizing;
+        frame = child;
+        goto enter;
+    }
+
+leave:
+    while (frame != root) {
+        frame--;
+        bool track_pv = self->track_pv && !self->mpc_probing;
+        if (frame->passing) {
+            // A pass node's value is its only child's value.
+            if (track_pv) {
+                SEARCH_FN(update_pv)(self, frame);
+            }
+            continue;
+        }
+
+        if (frame->maximizing) {
+            if (value > frame->best_value) {
+                frame->best_value = value;
+                if (track_pv) {
+                    SEARCH_FN(update_pv)(self, frame);
+                }
+            }
+            if (prune && frame->best_value > frame->alpha) {
+                frame->alpha = frame->best_value;
+            }
+        } else {
+            if (value < frame->best_value) {
+                frame->best_value = value;
+                if (track_pv) {
+                    SEARCH_FN(update_pv)(self, frame);
+                }
+            }
+            if (prune && frame->best_value < frame->beta) {
+                frame->beta = frame->best_value;
+            }
+        }
+        if (prune && frame->beta <= frame->alpha) {
+            frame->moves = 0;
+        }
+        goto next;
+    }
+
+    return value;
+}
+
+static int SEARCH_FN(start)(SearchContext* self, SearchFrame* root, uint64_t player_board, uint64_t opponent_board,
+                            int depth, int alpha, int beta, bool maximizing_player, bool prune) {
+    root->player_board = player_board;
+    root->opponent_board = opponent_board;
+    root->depth = depth;
+    root->alpha = alpha;
+    root->beta = beta;
+    root->maximizing = maximizing_player;
+    return SEARCH_FN(run)(self, root, prune);
+}
+
+static bool SEARCH_FN(probcut)(SearchContext* self, SearchFrame* frame, int* score) {
+    const MpcParams* params = &self->mpc->params[mpc_phase(frame->player_board, frame->opponent_board)][frame->depth];
+    if (params->sigma <= 0.0 || params->a <= 0.0) {
+        return false;
+    }
+
+    int depth = frame->depth;
+    int shallow = mpc_shallow_depth(depth);
+    bool cut = false;
+
+    // Probes run as if the whole search were shallower so ply-indexed state
+    // such as the NNUE accumulator stack stays aligned with this node. Their
+    // frames sit above this one, which the shallower depth always leaves room for.
+    self->mpc_probing = true;
+    self->max_depth -= depth - shallow;
+
+    if (frame->beta != INT_MAX) {
+        int bound = mpc_high_bound(self->mpc, params, frame->beta);
+        if (bound != INT_MAX && SEARCH_FN(start)(self, frame + 1, frame->player_board, frame->opponent_board, shallow,
+                                                 bound - 1, bound, frame->maximizing, true) >= bound) {
+            *score = frame->beta;
+            cut = true;
+        }
+    }
+    if (!cut && frame->alpha != INT_MIN) {
+        int bound = mpc_low_bound(self->mpc, params, frame->alpha);
+        if (bound != INT_MIN && SEARCH_FN(start)(self, frame + 1, frame->player_board, frame->opponent_board, shallow,
+                                                 bound, bound + 1, frame->maximizing, true) <= bound) {
+            *score = frame->alpha;
+            cut = true;
+        }
+    }
+
+    self->max_depth += depth - shallow;
+    self->mpc_probing = false;
+    return cut && !self->aborted;
+}
+
+static int SEARCH_FN(minimax)(uint64_t player_board, uint64_t opponent_board, int depth, bool maximizing_player, SearchContext* self) {
+    return SEARCH_FN(start)(self, self->frames, player_board, opponent_board, depth, INT_MIN, INT_MAX, maximizing_player, false);
+}
+
+static int SEARCH_FN(minimax_abp)(uint64_t player_board, uint64_t opponent_board, int depth, int alpha, int beta, bool maximizing_player, SearchContext* self) {
+    return SEARCH_FN(start)(self, self->frames, player_board, opponent_board, depth, alpha, beta, maximizing_player, true);
+}
+
+static const SearchFuncs SEARCH_FN(search_funcs) = {
+    SEARCH_FN(minimax),
+    SEARCH_FN(minimax_abp),
+};
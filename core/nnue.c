@@ -0,0 +1,216 @@
+// core/nnue.c
+
+#include "nnue.h"
+#include "board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NNUE_SIMD
+#include <immintrin.h>
+#endif
+
+typedef int32_t (*ForwardFunc)(const NnueNetwork* net, const int16_t* own, const int16_t* theirs);
+
+struct NnueNetwork {
+    // Feature rows are stored contiguously so an update touches one cache-friendly row.
+    int16_t feature_weights[NNUE_FEATURES][NNUE_HIDDEN];
+    int16_t feature_bias[NNUE_HIDDEN];
+    int8_t l2_weights[NNUE_L2][2 * NNUE_HIDDEN];
+    int32_t l2_bias[NNUE_L2];
+    int8_t output_weights[NNUE_L2];
+    int32_t output_bias;
+    ForwardFunc forward;
+};
+
+static inline uint8_t clip_activation(int32_t value) {
+    return (uint8_t)(value < 0 ? 0 : (value > NNUE_ACTIVATION_MAX ? NNUE_ACTIVATION_MAX : value));
+}
+
+static int32_t forward_scalar(const NnueNetwork* net, const int16_t* own, const int16_t* theirs) {
+    uint8_t input[2 * NNUE_HIDDEN];
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        input[i] = clip_activation(own[i]);
+        input[NNUE_HIDDEN + i] = clip_activation(theirs[i]);
+    }
+
+    int32_t output = net->output_bias;
+    for (int j = 0; j < NNUE_L2; j++) {
+        int32_t sum = net->l2_bias[j];
+        for (int i = 0; i < 2 * NNUE_HIDDEN; i++) {
+            sum += (int32_t)input[i] * net->l2_weights[j][i];
+        }
+        output += (int32_t)clip_activation(sum >> NNUE_WEIGHT_SHIFT) * net->output_weights[j];
+    }
+    return output;
+}
+
+#ifdef NNUE_SIMD
+__attribute__((target("avx2")))
+static inline __m256i clip_pack_avx2(const int16_t* values) {
+    const __m256i max = _mm256_set1_epi16(NNUE_ACTIVATION_MAX);
+    __m256i lo = _mm256_min_epi16(_mm256_loadu_si256((const __m256i*)values), max);
+    __m256i hi = _mm256_min_epi16(_mm256_loadu_si256((const __m256i*)(values + 16)), max);
+    // packus clamps negatives to 0 but interleaves 128-bit lanes, so restore the order.
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i dot_avx2(const __m256i* input, const int8_t* weights) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < 2 * NNUE_HIDDEN / 32; i++) {
+        __m256i w = _mm256_loadu_si256((const __m256i*)&weights[i * 32]);
+        // Activations are at most 127, so u8 * i8 pair sums cannot saturate int16.
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(input[i], w), ones));
+    }
+    return sum;
+}
+
+__attribute__((target("avx2")))
+static int32_t forward_avx2(const NnueNetwork* net, const int16_t* own, const int16_t* theirs) {
+    __m256i input[2 * NNUE_HIDDEN / 32];
+    for (int i = 0; i < NNUE_HIDDEN / 32; i++) {
+        input[i] = clip_pack_avx2(own + i * 32);
+        input[NNUE_HIDDEN / 32 + i] = clip_pack_avx2(theirs + i * 32);
+    }
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(NNUE_ACTIVATION_MAX);
+    int32_t hidden[NNUE_L2];
+
+    // Eight outputs at a time: horizontal adds fold eight dot products into one vector.
+    for (int j = 0; j < NNUE_L2; j += 8) {
+        __m256i s01 = _mm256_hadd_epi32(dot_avx2(input, net->l2_weights[j]), dot_avx2(input, net->l2_weights[j + 1]));
+        __m256i s23 = _mm256_hadd_epi32(dot_avx2(input, net->l2_weights[j + 2]), dot_avx2(input, net->l2_weights[j + 3]));
+        __m256i s45 = _mm256_hadd_epi32(dot_avx2(input, net->l2_weights[j + 4]), dot_avx2(input, net->l2_weights[j + 5]));
+        __m256i s67 = _mm256_hadd_epi32(dot_avx2(input, net->l2_weights[j + 6]), dot_avx2(input, net->l2_weights[j + 7]));
+        __m256i s0123 = _mm256_hadd_epi32(s01, s23);
+        __m256i s4567 = _mm256_hadd_epi32(s45, s67);
+        __m256i sums = _mm256_add_epi32(_mm256_permute2x128_si256(s0123, s4567, 0x20),
+                                        _mm256_permute2x128_si256(s0123, s4567, 0x31));
+        sums = _mm256_add_epi32(sums, _mm256_loadu_si256((const __m256i*)&net->l2_bias[j]));
+        sums = _mm256_srai_epi32(sums, NNUE_WEIGHT_SHIFT);
+        sums = _mm256_min_epi32(_mm256_max_epi32(sums, zero), max);
+        _mm256_storeu_si256((__m256i*)&hidden[j], sums);
+    }
+
+    int32_t output = net->output_bias;
+    for (int j = 0; j < NNUE_L2; j++) {
+        output += hidden[j] * net->output_weights[j];
+    }
+    return output;
+}
+#endif
+
+static int read_exact(FILE* file, void* buffer, size_t size) {
+    return fread(buffer, 1, size, file) == size ? 0 : -1;
+}
+
+NnueNetwork* nnue_load(const char* path, char* error, size_t error_size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        snprintf(error, error_size, "Cannot open NNUE weights '%s'.", path);
+        return NULL;
+    }
+
+    NnueNetwork* net = (NnueNetwork*)calloc(1, sizeof(NnueNetwork));
+    if (net == NULL) {
+        fclose(file);
+        snprintf(error, error_size, "Out of memory loading NNUE weights.");
+        return NULL;
+    }
+
+    char magic[8];
+    int32_t dims[3];
+    if (read_exact(file, magic, sizeof(magic)) < 0 || memcmp(magic, NNUE_MAGIC, sizeof(magic)) != 0 ||
+        read_exact(file, dims, sizeof(dims)) < 0) {
+        snprintf(error, error_size, "'%s' is not an NNUE weight file.", path);
+        goto fail;
+    }
+
+    if (dims[0] != NNUE_FEATURES || dims[1] != NNUE_HIDDEN || dims[2] != NNUE_L2) {
+        snprintf(error, error_size, "NNUE weights '%s' have shape %d/%d/%d, expected %d/%d/%d.", path,
+                 dims[0], dims[1], dims[2], NNUE_FEATURES, NNUE_HIDDEN, NNUE_L2);
+        goto fail;
+    }
+
+    if (read_exact(file, net->feature_weights, sizeof(net->feature_weights)) < 0 ||
+        read_exact(file, net->feature_bias, sizeof(net->feature_bias)) < 0 ||
+        read_exact(file, net->l2_weights, sizeof(net->l2_weights)) < 0 ||
+        read_exact(file, net->l2_bias, sizeof(net->l2_bias)) < 0 ||
+        read_exact(file, net->output_weights, sizeof(net->output_weights)) < 0 ||
+        read_exact(file, &net->output_bias, sizeof(net->output_bias)) < 0) {
+        snprintf(error, error_size, "NNUE weights '%s' are truncated.", path);
+        goto fail;
+    }
+
+    net->forward = forward_scalar;
+#ifdef NNUE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        net->forward = forward_avx2;
+    }
+#endif
+
+    fclose(file);
+    return net;
+
+fail:
+    fclose(file);
+    free(net);
+    return NULL;
+}
+
+void nnue_free(NnueNetwork* net) {
+    free(net);
+}
+
+static inline void add_feature(int16_t* values, const int16_t* row) {
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        values[i] += row[i];
+    }
+}
+
+static inline void move_feature(int16_t* values, const int16_t* add_row, const int16_t* sub_row) {
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        values[i] += add_row[i] - sub_row[i];
+    }
+}
+
+void nnue_refresh(const NnueNetwork* net, NnueAccumulator* acc, uint64_t player_board, uint64_t opponent_board) {
+    memcpy(acc->values[0], net->feature_bias, sizeof(net->feature_bias));
+    memcpy(acc->values[1], net->feature_bias, sizeof(net->feature_bias));
+
+    for (int sq = 0; sq < 64; sq++) {
+        if ((player_board >> sq) & 1ULL) {
+            add_feature(acc->values[0], net->feature_weights[sq]);
+            add_feature(acc->values[1], net->feature_weights[64 + sq]);
+        } else if ((opponent_board >> sq) & 1ULL) {
+            add_feature(acc->values[0], net->feature_weights[64 + sq]);
+            add_feature(acc->values[1], net->feature_weights[sq]);
+        }
+    }
+}
+
+void nnue_update(const NnueNetwork* net, const NnueAccumulator* parent, NnueAccumulator* child,
+                 int perspective, int move, uint64_t flips) {
+    int16_t* mover = child->values[perspective];
+    int16_t* other = child->values[perspective ^ 1];
+
+    memcpy(child, parent, sizeof(NnueAccumulator));
+    add_feature(mover, net->feature_weights[move]);
+    add_feature(other, net->feature_weights[64 + move]);
+
+    while (flips) {
+        int sq = popcount64((flips & (~flips + 1)) - 1);
+        flips &= flips - 1;
+        move_feature(mover, net->feature_weights[sq], net->feature_weights[64 + sq]);
+        move_feature(other, net->feature_weights[64 + sq], net->feature_weights[sq]);
+    }
+}
+
+int nnue_evaluate(const NnueNetwork* net, const NnueAccumulator* acc, int perspective) {
+    return net->forward(net, acc->values[perspective], acc->values[perspective ^ 1]) / NNUE_OUTPUT_SCALE;
+}
@@ -0,0 +1,43 @@
+// core/nnue.h
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Network shape: 128 board features (own/opponent disc per square) feed an
+// int16 accumulator per perspective, the two clipped accumulators feed an int8
+// dense layer, which feeds a single int8 output neuron.
+#define NNUE_FEATURES 128
+#define NNUE_HIDDEN 64
+#define NNUE_L2 32
+
+#define NNUE_ACTIVATION_MAX 127
+#define NNUE_WEIGHT_SHIFT 6
+#define NNUE_OUTPUT_SCALE 16
+
+#define NNUE_MAGIC "ONNUE001"
+
+typedef struct {
+    int16_t values[2][NNUE_HIDDEN];
+} NnueAccumulator;
+
+typedef struct NnueNetwork NnueNetwork;
+
+// Loads a weight file, returns NULL and fills error on failure.
+NnueNetwork* nnue_load(const char* path, char* error, size_t error_size);
+void nnue_free(NnueNetwork* net);
+
+// Rebuilds both perspectives from scratch. Perspective 0 owns player_board.
+void nnue_refresh(const NnueNetwork* net, NnueAccumulator* acc, uint64_t player_board, uint64_t opponent_board);
+
+// Derives the child accumulator after the side with the given perspective
+// plays move and flips the discs in flips.
+void nnue_update(const NnueNetwork* net, const NnueAccumulator* parent, NnueAccumulator* child,
+                 int perspective, int move, uint64_t flips);
+
+// Scores the position for the side to move, whose perspective is given.
+int nnue_evaluate(const NnueNetwork* net, const NnueAccumulator* acc, int perspective);
+
+#endif /* NNUE_H */
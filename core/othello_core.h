@@ -0,0 +1,189 @@
+// core/othello_core.h
+//
+// Public C API of the Othello engine. Has no Python dependency and is safe to
+// include from C++. Structs may gain fields at the end in later versions, so
+// always fill option structs with othello_search_options_init() first.
+
+#ifndef OTHELLO_CORE_H
+#define OTHELLO_CORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define OTHELLO_CORE_API_VERSION 1
+
+// Macro definitions for exporting/importing functions
+#ifdef _WIN32
+    #if defined(OTHELLO_STATIC)
+        #define OTHELLO_API
+    #elif defined(OTHELLO_EXPORTS)
+        #define OTHELLO_API __declspec(dllexport)
+    #else
+        #define OTHELLO_API __declspec(dllimport)
+    #endif
+#else
+    #define OTHELLO_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OTHELLO_PASS (-1)
+#define OTHELLO_MAX_MOVES 64
+#define OTHELLO_MAX_PV 60
+
+typedef enum {
+    OTHELLO_OK = 0,
+    OTHELLO_ERROR_INVALID_ARGUMENT,
+    OTHELLO_ERROR_UNKNOWN_EVALUATOR,
+    OTHELLO_ERROR_ILLEGAL_MOVE,
+    OTHELLO_ERROR_OUT_OF_MEMORY,
+    OTHELLO_ERROR_IO
+} OthelloStatus;
+
+// A position seen from the side to move. Squares are bits row * 8 + col.
+typedef struct {
+    uint64_t player;
+    uint64_t opponent;
+} OthelloPosition;
+
+// Game phases of a composed evaluator: at most 15 discs on the board, at most
+// 45, and the rest.
+#define OTHELLO_EVAL_PHASES 3
+
+// One weighted term of a composed evaluator. term names a built-in evaluator
+// such as "mobility_evaluate"; a non-zero "win_evaluate" weight makes decided
+// games score as win_evaluate does, whatever the other terms say.
+typedef struct {
+    const char* term;
+    int weights[OTHELLO_EVAL_PHASES];
+} OthelloEvalTerm;
+
+typedef struct {
+    int max_depth;
+    bool alpha_beta;
+    bool debug;
+    const char* evaluator;
+    const char* nnue_weights;
+    // 0 searches exactly max_depth; otherwise deepens iteratively up to
+    // max_depth and returns the deepest iteration finished in time.
+    int time_limit_ms;
+    // Multi-ProbCut parameters fitted by tools/mpc_calibrate for this
+    // evaluator, or NULL to search without selective pruning. A node is cut
+    // when its predicted score lies mpc_confidence deviations outside the window.
+    const char* mpc_params;
+    double mpc_confidence;
+    // Positions with at most this many empty squares are solved exactly and
+    // scored as final disc difference. 0 never switches to the solver.
+    int endgame_empties;
+    // Name of a table made with othello_shared_table_create() that alpha-beta
+    // searches in every process on the host share, or NULL for none.
+    const char* shared_table;
+    // When set, leaves are scored by the weighted sum of these terms, computed
+    // in one pass, instead of by evaluator ("composed_evaluate" for ProbCut).
+    const OthelloEvalTerm* eval_terms;
+    int eval_term_count;
+    // Parameter file of a composed evaluator, as written by tools/spsa_tune:
+    // term weights, phase limits and square values. Cannot be combined with
+    // eval_terms.
+    const char* eval_params;
+    // Megabytes of a direct-mapped cache of leaf scores kept by the engine
+    // across its searches, so each distinct leaf is evaluated once. 0 (the
+    // default) evaluates every leaf.
+    int eval_cache_mb;
+} OthelloSearchOptions;
+
+typedef struct {
+    int best_move;
+    int score;
+    uint64_t nodes;
+    int depth;
+} OthelloSearchResult;
+
+// One root move of an analysis. pv starts with move itself and may contain
+// OTHELLO_PASS entries.
+typedef struct {
+    int move;
+    int score;
+    int pv_length;
+    int pv[OTHELLO_MAX_PV];
+} OthelloMoveAnalysis;
+
+// An engine owns its search state and tables and reuses them across searches.
+// One engine must not be used from two threads at the same time.
+typedef struct OthelloEngine OthelloEngine;
+
+OTHELLO_API int othello_api_version(void);
+OTHELLO_API const char* othello_status_string(OthelloStatus status);
+
+OTHELLO_API OthelloPosition othello_initial_position(void);
+OTHELLO_API uint64_t othello_legal_moves(const OthelloPosition* position);
+OTHELLO_API uint64_t othello_flips(const OthelloPosition* position, int move);
+OTHELLO_API bool othello_is_game_over(const OthelloPosition* position);
+
+// Plays move (or OTHELLO_PASS) and flips the position to the other side.
+OTHELLO_API OthelloStatus othello_make_move(OthelloPosition* position, int move);
+
+OTHELLO_API OthelloStatus othello_evaluate(const char* evaluator, const OthelloPosition* position, int* score);
+
+OTHELLO_API void othello_search_options_init(OthelloSearchOptions* options);
+OTHELLO_API OthelloEngine* othello_engine_create(const OthelloSearchOptions* options, OthelloStatus* status);
+OTHELLO_API void othello_engine_destroy(OthelloEngine* engine);
+OTHELLO_API OthelloStatus othello_engine_search(OthelloEngine* engine, const OthelloPosition* position, OthelloSearchResult* result);
+
+// Scores every legal move with its principal variation, best first. moves
+// must have room for OTHELLO_MAX_MOVES entries; count is 0 when the side to
+// move has to pass. Exactly solved positions report only the root move as pv.
+OTHELLO_API OthelloStatus othello_engine_analyze(OthelloEngine* engine, const OthelloPosition* position,
+                                                 OthelloMoveAnalysis* moves, int* count);
+
+// Leaf evaluation cache lookups since the engine was created; both are 0
+// without a cache.
+OTHELLO_API void othello_engine_eval_cache_stats(const OthelloEngine* engine, uint64_t* hits, uint64_t* misses);
+
+// Makes a running othello_engine_search on another thread return promptly with
+// its best result so far. The request is cleared when the next search starts.
+OTHELLO_API void othello_engine_stop(OthelloEngine* engine);
+
+// One-shot search that creates and destroys an engine internally.
+OTHELLO_API OthelloStatus othello_search(const OthelloPosition* position, const OthelloSearchOptions* options, OthelloSearchResult* result);
+
+// Shared transposition table: a named POSIX shared-memory segment of size_mb
+// megabytes. create fails if the name is taken; destroy removes the name, and
+// processes still using the table keep it until their engines are destroyed.
+OTHELLO_API OthelloStatus othello_shared_table_create(const char* name, size_t size_mb);
+OTHELLO_API OthelloStatus othello_shared_table_destroy(const char* name);
+
+// Other board sizes: 4x4, 6x6, 8x8 and, where the compiler has 128-bit
+// integers, 10x10. Squares are row * size + col, split over two words (bits
+// 0-63, then 64-127), and positions are seen from the side to move.
+#define OTHELLO_MAX_BOARD_SIZE 10
+
+typedef struct {
+    int size;
+    uint64_t player[2];
+    uint64_t opponent[2];
+} OthelloSizedPosition;
+
+OTHELLO_API bool othello_sized_supported(int size);
+OTHELLO_API OthelloStatus othello_sized_initial_position(int size, OthelloSizedPosition* position);
+
+// Fills moves (room for size * size entries) and returns their count.
+OTHELLO_API int othello_sized_legal_moves(const OthelloSizedPosition* position, int* moves);
+OTHELLO_API OthelloStatus othello_sized_make_move(OthelloSizedPosition* position, int move);
+
+// Perfect play to the end of the game: score is the final disc difference
+// with empties credited to the winner, depth the number of empties solved.
+OTHELLO_API OthelloStatus othello_sized_solve(const OthelloSizedPosition* position, OthelloSearchResult* result);
+
+// Alpha-beta to depth plies on mobility and corners; positions decided
+// within the horizon score 1000 per disc of the final difference.
+OTHELLO_API OthelloStatus othello_sized_search(const OthelloSizedPosition* position, int depth, OthelloSearchResult* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTHELLO_CORE_H */
@@ -0,0 +1,179 @@
+// core/parallel.c
+
+#include "parallel.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+typedef struct {
+    ParallelWorker worker;
+    void* ctx;
+    int thread_index;
+    int thread_count;
+} ParallelTask;
+
+int default_thread_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = (int)info.dwNumberOfProcessors;
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? count : 1;
+}
+
+long parallel_fetch_add(volatile long* counter, long amount) {
+#ifdef _WIN32
+    return InterlockedExchangeAdd(counter, amount);
+#else
+    return __atomic_fetch_add(counter, amount, __ATOMIC_RELAXED);
+#endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI parallel_entry(LPVOID arg) {
+    ParallelTask* task = (ParallelTask*)arg;
+    task->worker(task->ctx, task->thread_index, task->thread_count);
+    return 0;
+}
+#else
+static void* parallel_entry(void* arg) {
+    ParallelTask* task = (ParallelTask*)arg;
+    task->worker(task->ctx, task->thread_index, task->thread_count);
+    return NULL;
+}
+#endif
+
+int run_parallel(int thread_count, ParallelWorker worker, void* ctx) {
+    if (thread_count <= 1) {
+        worker(ctx, 0, 1);
+        return 0;
+    }
+
+    ParallelTask* tasks = (ParallelTask*)malloc(sizeof(ParallelTask) * thread_count);
+#ifdef _WIN32
+    HANDLE* threads = (HANDLE*)malloc(sizeof(HANDLE) * thread_count);
+#else
+    pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * thread_count);
+#endif
+    if (tasks == NULL || threads == NULL) {
+        free(tasks);
+        free(threads);
+        return -1;
+    }
+
+    // Thread 0 runs on the calling thread; a failed spawn falls back to running inline.
+    for (int i = 1; i < thread_count; i++) {
+        tasks[i].worker = worker;
+        tasks[i].ctx = ctx;
+        tasks[i].thread_index = i;
+        tasks[i].thread_count = thread_count;
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, parallel_entry, &tasks[i], 0, NULL);
+        if (threads[i] == NULL) {
+            parallel_entry(&tasks[i]);
+        }
+#else
+        if (pthread_create(&threads[i], NULL, parallel_entry, &tasks[i]) != 0) {
+            tasks[i].thread_count = -1;
+            worker(ctx, i, thread_count);
+        }
+#endif
+    }
+
+    worker(ctx, 0, thread_count);
+
+    for (int i = 1; i < thread_count; i++) {
+#ifdef _WIN32
+        if (threads[i] != NULL) {
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+        }
+#else
+        if (tasks[i].thread_count != -1) {
+            pthread_join(threads[i], NULL);
+        }
+#endif
+    }
+
+    free(tasks);
+    free(threads);
+    return 0;
+}
+
+typedef struct {
+    void (*fn)(void* arg);
+    void* arg;
+} ThreadStart;
+
+#ifdef _WIN32
+static DWORD WINAPI thread_entry(LPVOID raw) {
+#else
+static void* thread_entry(void* raw) {
+#endif
+    ThreadStart start = *(ThreadStart*)raw;
+    free(raw);
+    start.fn(start.arg);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+int parallel_thread_start(ParallelThread* thread, void (*fn)(void* arg), void* arg) {
+    ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+    thread->started = false;
+    if (start == NULL) {
+        return -1;
+    }
+    start->fn = fn;
+    start->arg = arg;
+
+#ifdef _WIN32
+    HANDLE handle = CreateThread(NULL, 0, thread_entry, start, 0, NULL);
+    if (handle == NULL) {
+        free(start);
+        return -1;
+    }
+    thread->handle = handle;
+#else
+    if (pthread_create(&thread->handle, NULL, thread_entry, start) != 0) {
+        free(start);
+        return -1;
+    }
+#endif
+    thread->started = true;
+    return 0;
+}
+
+void parallel_thread_join(ParallelThread* thread) {
+    if (!thread->started) {
+        return;
+    }
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    thread->started = false;
+}
+
+void parallel_thread_detach(ParallelThread* thread) {
+    if (!thread->started) {
+        return;
+    }
+#ifdef _WIN32
+    CloseHandle((HANDLE)thread->handle);
+#else
+    pthread_detach(thread->handle);
+#endif
+    thread->started = false;
+}
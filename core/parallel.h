@@ -0,0 +1,39 @@
+// core/parallel.h
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdbool.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+typedef void (*ParallelWorker)(void* ctx, int thread_index, int thread_count);
+
+// Number of online CPUs, at least 1.
+int default_thread_count(void);
+
+// Runs worker on thread_count native threads and joins them all.
+// Must be called without holding the GIL when the worker is long running.
+int run_parallel(int thread_count, ParallelWorker worker, void* ctx);
+
+typedef struct {
+#ifdef _WIN32
+    void* handle;
+#else
+    pthread_t handle;
+#endif
+    bool started;
+} ParallelThread;
+
+// Starts fn(arg) on a new native thread; join it with parallel_thread_join.
+int parallel_thread_start(ParallelThread* thread, void (*fn)(void* arg), void* arg);
+void parallel_thread_join(ParallelThread* thread);
+// Lets a started thread finish on its own.
+void parallel_thread_detach(ParallelThread* thread);
+
+// Atomically increments *counter and returns its previous value.
+long parallel_fetch_add(volatile long* counter, long amount);
+
+#endif /* PARALLEL_H */
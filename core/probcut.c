@@ -0,0 +1,90 @@
+// core/probcut.c
+
+#include "probcut.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+MpcTable* mpc_load(const char* path, const char* evaluator, double confidence, char* error, size_t error_size) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        snprintf(error, error_size, "Cannot open ProbCut parameters '%s'.", path);
+        return NULL;
+    }
+
+    MpcTable* table = (MpcTable*)calloc(1, sizeof(MpcTable));
+    if (table == NULL) {
+        fclose(file);
+        snprintf(error, error_size, "Out of memory loading ProbCut parameters.");
+        return NULL;
+    }
+    table->confidence = confidence;
+
+    char line[256];
+    if (fgets(line, sizeof(line), file) == NULL || strncmp(line, MPC_MAGIC, strlen(MPC_MAGIC)) != 0) {
+        snprintf(error, error_size, "'%s' is not a ProbCut parameter file.", path);
+        goto fail;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        int phase, depth, samples;
+        double a, b, sigma;
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0') {
+            continue;
+        }
+        if (sscanf(line, "evaluator %63s", table->evaluator) == 1) {
+            continue;
+        }
+        if (sscanf(line, "%d %d %lf %lf %lf %d", &phase, &depth, &a, &b, &sigma, &samples) != 6 ||
+            phase < 0 || phase >= MPC_PHASES || depth < MPC_MIN_DEPTH || depth > MPC_MAX_DEPTH) {
+            snprintf(error, error_size, "Malformed ProbCut parameter line in '%s': %s", path, line);
+            goto fail;
+        }
+
+        MpcParams* params = &table->params[phase][depth];
+        params->a = a;
+        params->b = b;
+        params->sigma = sigma;
+        params->samples = samples;
+    }
+
+    if (strcmp(table->evaluator, evaluator) != 0) {
+        snprintf(error, error_size, "ProbCut parameters '%s' were fitted for '%s', not '%s'.", path, table->evaluator, evaluator);
+        goto fail;
+    }
+
+    fclose(file);
+    return table;
+
+fail:
+    fclose(file);
+    free(table);
+    return NULL;
+}
+
+void mpc_free(MpcTable* table) {
+    free(table);
+}
+
+bool mpc_save(const MpcTable* table, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+
+    fprintf(file, "%s\n", MPC_MAGIC);
+    fprintf(file, "evaluator %s\n", table->evaluator);
+    fprintf(file, "# phase depth a b sigma samples (probe depth = depth - 2 * ((depth + 2) / 4))\n");
+    for (int phase = 0; phase < MPC_PHASES; phase++) {
+        for (int depth = MPC_MIN_DEPTH; depth <= MPC_MAX_DEPTH; depth++) {
+            const MpcParams* params = &table->params[phase][depth];
+            if (params->samples > 0) {
+                fprintf(file, "%d %d %.6f %.3f %.3f %d\n", phase, depth, params->a, params->b, params->sigma, params->samples);
+            }
+        }
+    }
+
+    return fclose(file) == 0;
+}
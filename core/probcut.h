@@ -0,0 +1,76 @@
+// core/probcut.h
+
+#ifndef PROBCUT_H
+#define PROBCUT_H
+
+#include "board.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Multi-ProbCut predicts the depth-d score of a node from a shallow search as
+// a * shallow + b with residual deviation sigma, fitted separately per game
+// phase and depth by tools/mpc_calibrate.
+#define MPC_PHASES 4
+#define MPC_MIN_DEPTH 3
+#define MPC_MAX_DEPTH 24
+
+#define MPC_MAGIC "othello-mpc 1"
+
+typedef struct {
+    double a;
+    double b;
+    double sigma;
+    int samples;
+} MpcParams;
+
+typedef struct {
+    char evaluator[64];
+    double confidence;
+    // Rows with sigma <= 0 were not fitted and never cut.
+    MpcParams params[MPC_PHASES][MPC_MAX_DEPTH + 1];
+} MpcTable;
+
+// Depth of the probe for a depth-d node. It keeps the parity of depth so both
+// searches score their leaves for the same side.
+static inline int mpc_shallow_depth(int depth) {
+    return depth - 2 * ((depth + 2) / 4);
+}
+
+static inline int mpc_phase(uint64_t player_board, uint64_t opponent_board) {
+    int discs = popcount64(player_board | opponent_board);
+    int phase = (discs - 4) / 15;
+    return phase < MPC_PHASES ? phase : MPC_PHASES - 1;
+}
+
+// Shallow-search score at or above which the deep score is predicted to reach
+// beta with the table's confidence, or INT_MAX when no probe can decide it.
+static inline int mpc_high_bound(const MpcTable* table, const MpcParams* params, int beta) {
+    double bound = (beta + table->confidence * params->sigma - params->b) / params->a;
+    if (bound >= (double)INT_MAX) {
+        return INT_MAX;
+    }
+    int rounded = (int)bound;
+    return rounded < bound ? rounded + 1 : rounded;
+}
+
+// Shallow-search score at or below which the deep score is predicted to stay
+// under alpha, or INT_MIN when no probe can decide it.
+static inline int mpc_low_bound(const MpcTable* table, const MpcParams* params, int alpha) {
+    double bound = (alpha - table->confidence * params->sigma - params->b) / params->a;
+    if (bound <= (double)INT_MIN) {
+        return INT_MIN;
+    }
+    int rounded = (int)bound;
+    return rounded > bound ? rounded - 1 : rounded;
+}
+
+// Loads a parameter file fitted for evaluator. Returns NULL and fills error on
+// failure, including when the file was fitted for another evaluator.
+MpcTable* mpc_load(const char* path, const char* evaluator, double confidence, char* error, size_t error_size);
+void mpc_free(MpcTable* table);
+
+bool mpc_save(const MpcTable* table, const char* path);
+
+#endif /* PROBCUT_H */
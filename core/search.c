@@ -0,0 +1,396 @@
+// core/search.c
+
+#include "search.h"
+#include "evaluate.h"
+#include "endgame.h"
+#include "board.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+static SearchFrame* alloc_frames(int count) {
+#ifdef _WIN32
+    return (SearchFrame*)_aligned_malloc(sizeof(SearchFrame) * count, sizeof(SearchFrame));
+#else
+    void* frames = NULL;
+    return posix_memalign(&frames, sizeof(SearchFrame), sizeof(SearchFrame) * count) == 0 ? (SearchFrame*)frames : NULL;
+#endif
+}
+
+static void free_frames(SearchFrame* frames) {
+#ifdef _WIN32
+    _aligned_free(frames);
+#else
+    free(frames);
+#endif
+}
+
+// Folds a file's bytes into an FNV-1a hash. The file was just loaded, so a
+// read error only weakens the salt.
+static uint64_t salt_file(uint64_t salt, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return salt;
+    }
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        salt = (salt ^ (unsigned char)c) * 0x100000001B3ULL;
+    }
+    fclose(file);
+    return salt;
+}
+
+OthelloStatus search_context_init(SearchContext* ctx, const OthelloSearchOptions* options, char* error, size_t error_size) {
+    memset(ctx, 0, sizeof(SearchContext));
+
+    if (options->max_depth < 1) {
+        snprintf(error, error_size, "max_depth must be at least 1.");
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (options->eval_terms != NULL && options->eval_params != NULL) {
+        snprintf(error, error_size, "eval_terms and eval_params cannot be combined.");
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+    const char* evaluator = options->evaluator ? options->evaluator : "combined_evaluate";
+    if (options->eval_terms != NULL || options->eval_params != NULL) {
+        evaluator = "composed_evaluate";
+    }
+    ctx->max_depth = options->max_depth;
+    ctx->depth_limit = options->max_depth;
+    ctx->time_limit_ms = options->time_limit_ms;
+    ctx->debug = options->debug;
+    ctx->abp = options->alpha_beta;
+    ctx->endgame_empties = options->endgame_empties;
+    ctx->search = find_search_funcs(evaluator, ctx->debug);
+
+    ctx->frames = alloc_frames(ctx->max_depth + 1);
+    ctx->pv = (signed char*)malloc((size_t)(ctx->max_depth + 1) * (ctx->max_depth + 1));
+    if (ctx->frames == NULL || ctx->pv == NULL) {
+        search_context_free(ctx);
+        snprintf(error, error_size, "Out of memory.");
+        return OTHELLO_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (options->eval_terms != NULL || options->eval_params != NULL) {
+        ctx->composer = (ComposedEvaluator*)malloc(sizeof(ComposedEvaluator));
+        if (ctx->composer == NULL) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "Out of memory.");
+            return OTHELLO_ERROR_OUT_OF_MEMORY;
+        }
+
+        OthelloStatus status = options->eval_params != NULL
+            ? composed_evaluator_load(ctx->composer, options->eval_params, error, error_size)
+            : composed_evaluator_init(ctx->composer, options->eval_terms, options->eval_term_count, error, error_size);
+        if (status != OTHELLO_OK) {
+            search_context_free(ctx);
+            return status;
+        }
+    } else if (strcmp(evaluator, "nnue_evaluate") == 0) {
+        if (options->nnue_weights == NULL) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "nnue_evaluate requires nnue_weights=<path>.");
+            return OTHELLO_ERROR_INVALID_ARGUMENT;
+        }
+
+        ctx->nnue = nnue_load(options->nnue_weights, error, error_size);
+        if (ctx->nnue == NULL) {
+            search_context_free(ctx);
+            return OTHELLO_ERROR_IO;
+        }
+
+        ctx->nnue_stack = (NnueAccumulator*)malloc(sizeof(NnueAccumulator) * (ctx->max_depth + 1));
+        if (ctx->nnue_stack == NULL) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "Out of memory.");
+            return OTHELLO_ERROR_OUT_OF_MEMORY;
+        }
+    } else {
+        ctx->evaluate_func = find_eval_func(evaluator);
+        if (ctx->evaluate_func == NULL) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "Unknown evaluation strategy: '%s'", evaluator);
+            return OTHELLO_ERROR_UNKNOWN_EVALUATOR;
+        }
+    }
+
+    if (options->eval_cache_mb < 0) {
+        search_context_free(ctx);
+        snprintf(error, error_size, "eval_cache_mb must not be negative.");
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+    // random_evaluate's scores are not a function of the position.
+    if (options->eval_cache_mb > 0 && strcmp(evaluator, "random_evaluate") != 0) {
+        ctx->eval_cache = eval_cache_create((size_t)options->eval_cache_mb);
+        if (ctx->eval_cache == NULL) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "Out of memory.");
+            return OTHELLO_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (options->mpc_params != NULL) {
+        if (options->mpc_confidence <= 0.0) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "mpc_confidence must be positive.");
+            return OTHELLO_ERROR_INVALID_ARGUMENT;
+        }
+
+        ctx->mpc = mpc_load(options->mpc_params, evaluator, options->mpc_confidence, error, error_size);
+        if (ctx->mpc == NULL) {
+            search_context_free(ctx);
+            return OTHELLO_ERROR_IO;
+        }
+    }
+
+    // random_evaluate stays out of the table for the same reason.
+    if (options->shared_table != NULL && strcmp(evaluator, "random_evaluate") != 0) {
+        if (!ctx->abp) {
+            search_context_free(ctx);
+            snprintf(error, error_size, "shared_table requires alpha-beta search.");
+            return OTHELLO_ERROR_INVALID_ARGUMENT;
+        }
+
+        ctx->table = shared_table_attach(options->shared_table, error, error_size);
+        if (ctx->table == NULL) {
+            search_context_free(ctx);
+            return OTHELLO_ERROR_IO;
+        }
+
+        // FNV-1a over the evaluator name, the NNUE weights, the ProbCut
+        // parameters and confidence, and the composed evaluator's parameters.
+        uint64_t salt = 0xCBF29CE484222325ULL;
+        for (const char* c = evaluator; *c; c++) {
+            salt = (salt ^ (unsigned char)*c) * 0x100000001B3ULL;
+        }
+        if (ctx->nnue != NULL) {
+            salt = salt_file(salt, options->nnue_weights);
+        }
+        if (ctx->mpc != NULL) {
+            salt = salt_file(salt, options->mpc_params);
+            salt = (salt ^ (uint64_t)(ctx->mpc->confidence * 1000.0 + 1.0)) * 0x100000001B3ULL;
+        }
+        if (ctx->composer != NULL) {
+            const int* params = &ctx->composer->weights[0][0];
+            for (size_t i = 0; i < sizeof(ComposedEvaluator) / sizeof(int); i++) {
+                salt = (salt ^ (uint32_t)params[i]) * 0x100000001B3ULL;
+            }
+        }
+        ctx->table_salt = salt;
+    }
+
+    return OTHELLO_OK;
+}
+
+void search_context_free(SearchContext* ctx) {
+    nnue_free(ctx->nnue);
+    free(ctx->nnue_stack);
+    free(ctx->composer);
+    mpc_free(ctx->mpc);
+    free_frames(ctx->frames);
+    free(ctx->pv);
+    shared_table_release(ctx->table);
+    eval_cache_free(ctx->eval_cache);
+    ctx->nnue = NULL;
+    ctx->nnue_stack = NULL;
+    ctx->composer = NULL;
+    ctx->mpc = NULL;
+    ctx->frames = NULL;
+    ctx->pv = NULL;
+    ctx->table = NULL;
+    ctx->eval_cache = NULL;
+}
+
+int search_root_moves(SearchContext* self, uint64_t player_board, uint64_t opponent_board, RootMoveList* root_moves) {
+    MoveList valid_moves;
+    get_valid_moves(player_board, opponent_board, &valid_moves);
+
+    self->aborted = false;
+    root_moves->count = 0;
+    root_moves->best_index = -1;
+    root_moves->depth = self->max_depth;
+
+    if (self->nnue) {
+        nnue_refresh(self->nnue, &self->nnue_stack[0], player_board, opponent_board);
+    }
+
+    int empties = 64 - popcount64(player_board | opponent_board);
+    bool solve_exactly = empties <= self->endgame_empties;
+    root_moves->exact = solve_exactly;
+    if (solve_exactly) {
+        root_moves->depth = empties;
+    }
+
+    if (valid_moves.count == 0) {
+        if (solve_exactly) {
+            return -endgame_solve(self, opponent_board, player_board, -64, 64);
+        }
+        update_accumulator(self, 0, -1, player_board, player_board);
+        if (self->abp) {
+            return self->search->minimax_abp(opponent_board, player_board, self->max_depth - 1, INT_MIN, INT_MAX, false, self);
+        }
+        return self->search->minimax(opponent_board, player_board, self->max_depth - 1, false, self);
+    }
+
+    int best_score = INT_MIN;
+
+    for (int i = 0; i < valid_moves.count; i++) {
+        int move = valid_moves.moves[i];
+
+        uint64_t new_player_board = player_board;
+        uint64_t new_opponent_board = opponent_board;
+
+        BitList bits_to_flip;
+        get_flipped_bits(move, player_board, opponent_board, &bits_to_flip);
+        new_player_board |= 1ULL << move;
+        for (int j = 0; j < bits_to_flip.count; j++) {
+            int bit = bits_to_flip.bits[j];
+            new_player_board |= 1ULL << bit;
+            new_opponent_board &= ~(1ULL << bit);
+        }
+
+        update_accumulator(self, 0, move, player_board, new_player_board);
+
+        int score;
+        if (solve_exactly) {
+            score = -endgame_solve(self, new_opponent_board, new_player_board, -64, 64);
+        } else if (self->abp) {
+            score = self->search->minimax_abp(new_opponent_board, new_player_board, self->max_depth - 1, INT_MIN, INT_MAX, false, self);
+        } else {
+            score = self->search->minimax(new_opponent_board, new_player_board, self->max_depth - 1, false, self);
+        }
+
+        if (self->aborted) {
+            break;
+        }
+
+        RootMove* root_move = &root_moves->moves[root_moves->count];
+        root_move->move = move;
+        root_move->score = score;
+        root_move->pv[0] = (signed char)move;
+        root_move->pv_length = 1;
+        if (self->track_pv && !solve_exactly) {
+            int length = self->frames[0].pv_length;
+            if (length > MAX_PV_LENGTH - 1) {
+                length = MAX_PV_LENGTH - 1;
+            }
+            memcpy(&root_move->pv[1], self->pv, (size_t)length);
+            root_move->pv_length += length;
+        }
+        if (score > best_score) {
+            best_score = score;
+            root_moves->best_index = root_moves->count;
+        }
+        root_moves->count++;
+    }
+
+    return best_score;
+}
+
+int search_root(SearchContext* self, uint64_t player_board, uint64_t opponent_board, int* best_move) {
+    RootMoveList root_moves;
+    int score = search_root_moves(self, player_board, opponent_board, &root_moves);
+    *best_move = root_moves.best_index >= 0 ? root_moves.moves[root_moves.best_index].move : -1;
+    return score;
+}
+
+int search_iterative(SearchContext* self, uint64_t player_board, uint64_t opponent_board, RootMoveList* root_moves) {
+    RootMoveList current;
+    int best_score = 0;
+    int stable_iterations = 1;
+
+    uint64_t start = monotonic_ns();
+    if (self->budget) {
+        self->deadline_ns = start + self->budget->hard_ns;
+    } else {
+        self->deadline_ns = self->time_limit_ms > 0 ? start + (uint64_t)self->time_limit_ms * 1000000ULL : 0;
+    }
+    root_moves->count = 0;
+    root_moves->best_index = -1;
+    root_moves->depth = 0;
+    root_moves->exact = false;
+
+    for (int depth = 1; depth <= self->depth_limit; depth++) {
+        self->max_depth = depth;
+        int score = search_root_moves(self, player_board, opponent_board, &current);
+
+        if (self->aborted) {
+            // An interrupted first iteration still beats having no move at all.
+            if (root_moves->depth == 0 && current.count > 0) {
+                *root_moves = current;
+                root_moves->depth = 0;
+                root_moves->exact = false;
+                best_score = current.moves[current.best_index].score;
+            }
+            break;
+        }
+
+        if (depth > 1 && current.count > 0 && root_moves->count > 0) {
+            bool same_move = current.moves[current.best_index].move == root_moves->moves[root_moves->best_index].move;
+            stable_iterations = same_move ? stable_iterations + 1 : 0;
+        }
+        *root_moves = current;
+        best_score = score;
+        // The exact solve ignores the depth, so every further iteration would repeat it.
+        if (current.exact) {
+            break;
+        }
+        // The next iteration usually costs at least as much as all previous ones.
+        if (self->budget && (monotonic_ns() - start) * 2 >= time_budget_allowance(self->budget, stable_iterations)) {
+            break;
+        }
+    }
+
+    if (root_moves->count == 0) {
+        MoveList valid_moves;
+        get_valid_moves(player_board, opponent_board, &valid_moves);
+        if (valid_moves.count > 0) {
+            root_moves->moves[0].move = valid_moves.moves[0];
+            root_moves->moves[0].score = 0;
+            root_moves->moves[0].pv[0] = (signed char)valid_moves.moves[0];
+            root_moves->moves[0].pv_length = 1;
+            root_moves->count = 1;
+            root_moves->best_index = 0;
+        }
+    }
+
+    self->max_depth = self->depth_limit;
+    self->deadline_ns = 0;
+    return best_score;
+}
+
+int search_analyze(SearchContext* self, uint64_t player_board, uint64_t opponent_board, RootMoveList* root_moves) {
+    int score;
+
+    self->track_pv = true;
+    if (self->time_limit_ms > 0) {
+        score = search_iterative(self, player_board, opponent_board, root_moves);
+    } else {
+        score = search_root_moves(self, player_board, opponent_board, root_moves);
+    }
+    self->track_pv = false;
+
+    // Insertion sort keeps equally scored moves in generation order.
+    for (int i = 1; i < root_moves->count; i++) {
+        RootMove move = root_moves->moves[i];
+        int j = i;
+        while (j > 0 && root_moves->moves[j - 1].score < move.score) {
+            root_moves->moves[j] = root_moves->moves[j - 1];
+            j--;
+        }
+        root_moves->moves[j] = move;
+    }
+    root_moves->best_index = root_moves->count > 0 ? 0 : -1;
+
+    return score;
+}
+
+void search_request_stop(SearchContext* self) {
+    self->stop_requested = 1;
+}
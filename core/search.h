@@ -0,0 +1,155 @@
+// core/search.h
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "othello_core.h"
+#include "eval_cache.h"
+#include "nnue.h"
+#include "probcut.h"
+#include "shared_table.h"
+#include "timeman.h"
+#include "timer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int (*EvalFunc)(uint64_t player_board, uint64_t opponent_board);
+
+typedef struct SearchContext SearchContext;
+typedef struct ComposedEvaluator ComposedEvaluator;
+
+#if defined(_MSC_VER)
+#define SEARCH_CACHE_ALIGNED __declspec(align(64))
+#else
+#define SEARCH_CACHE_ALIGNED __attribute__((aligned(64)))
+#endif
+
+// One ply of the explicit search stack, padded to its own cache line. moves
+// holds the moves still to be tried; passing marks a node whose only child is
+// the opponent's reply to a pass. current_move and pv_length feed the
+// principal variation when the context tracks it. original_alpha and
+// original_beta keep the window the node was entered with for the shared table.
+typedef struct SEARCH_CACHE_ALIGNED SearchFrame {
+    uint64_t player_board;
+    uint64_t opponent_board;
+    uint64_t moves;
+    int alpha;
+    int beta;
+    int best_value;
+    int depth;
+    bool maximizing;
+    bool passing;
+    signed char current_move;
+    signed char pv_length;
+    int original_alpha;
+    int original_beta;
+} SearchFrame;
+
+typedef struct {
+    int (*minimax)(uint64_t player_board, uint64_t opponent_board, int depth, bool maximizing_player, SearchContext* self);
+    int (*minimax_abp)(uint64_t player_board, uint64_t opponent_board, int depth, int alpha, int beta, bool maximizing_player, SearchContext* self);
+} SearchFuncs;
+
+struct SearchContext {
+    int max_depth;
+    int depth_limit;
+    bool debug;
+    uint64_t iter;
+    bool abp;
+    int time_limit_ms;
+    // Set for a single clock-managed search; takes precedence over time_limit_ms.
+    const TimeBudget* budget;
+    uint64_t deadline_ns;
+    volatile long stop_requested;
+    bool aborted;
+    EvalFunc evaluate_func;
+    const SearchFuncs* search;
+    NnueNetwork* nnue;
+    NnueAccumulator* nnue_stack;
+    ComposedEvaluator* composer;
+    MpcTable* mpc;
+    bool mpc_probing;
+    int endgame_empties;
+    // Shared transposition table, or NULL. Its keys are salted with the
+    // evaluator and ProbCut settings so differently configured searches
+    // sharing one table never read each other's scores.
+    SharedTable* table;
+    uint64_t table_salt;
+    // Leaf scores of this context's evaluator, or NULL.
+    EvalCache* eval_cache;
+    // max_depth + 1 frames, allocated once with the context.
+    SearchFrame* frames;
+    // When set, frame i keeps the best line below it in pv[i * (depth_limit + 1)].
+    bool track_pv;
+    signed char* pv;
+};
+
+#define MAX_ROOT_MOVES 64
+#define MAX_PV_LENGTH 60
+
+typedef struct {
+    int move;
+    int score;
+    // Filled only when the context tracks the principal variation; starts with move.
+    int pv_length;
+    signed char pv[MAX_PV_LENGTH];
+} RootMove;
+
+// Scores of the root moves searched so far, in move-generation order.
+typedef struct {
+    RootMove moves[MAX_ROOT_MOVES];
+    int count;
+    int best_index;
+    int depth;
+    // Set when the root was solved exactly; depth is then the empty squares.
+    bool exact;
+} RootMoveList;
+
+// Checked every SEARCH_STOP_CHECK_MASK + 1 nodes; once it returns true the
+// search unwinds with aborted set and its partial results are discarded. 128
+// nodes keeps the stop latency well under a millisecond with the slowest
+// evaluator (win_evaluate) while clock reads stay negligible with the fastest.
+#define SEARCH_STOP_CHECK_MASK 127
+
+static inline bool search_should_stop(const SearchContext* ctx) {
+    return ctx->stop_requested || (ctx->deadline_ns && monotonic_ns() >= ctx->deadline_ns);
+}
+
+// A node's value depends on whose turn it is to maximize as well as on the
+// position, and leaves are scored for their own side to move, so the parity of
+// the remaining depth decides whose view the value takes. Both go into the key.
+static inline uint64_t search_table_key(const SearchContext* ctx, const SearchFrame* frame) {
+    return shared_table_key(frame->player_board, frame->opponent_board,
+                            ctx->table_salt ^ (frame->maximizing ? 0x5851F42D4C957F2DULL : 0) ^
+                                ((frame->depth & 1) ? 0x14057B7EF767814FULL : 0));
+}
+
+// Sets up ctx from options. On failure ctx holds no resources and error
+// describes the problem.
+OthelloStatus search_context_init(SearchContext* ctx, const OthelloSearchOptions* options, char* error, size_t error_size);
+void search_context_free(SearchContext* ctx);
+
+// Runs the root search for the side to move and returns the best score.
+// best_move is set to -1 when the side to move has to pass.
+int search_root(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, int* best_move);
+
+// Like search_root at ctx->max_depth, but keeps the score of every root move.
+// The list is empty when the side to move has to pass.
+int search_root_moves(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, RootMoveList* moves);
+
+// Iterative deepening up to ctx->depth_limit, stopping at ctx->time_limit_ms or
+// on search_request_stop(). With ctx->budget set, no new iteration starts once
+// half the allowance for the current best move's stability is used, and
+// hard_ns aborts the search. moves holds the deepest completed iteration.
+int search_iterative(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, RootMoveList* moves);
+
+// Multi-PV analysis: searches like othello_engine_search (iteratively when the
+// context has a time limit) with principal variations tracked, then sorts the
+// root moves best first. best_index is 0 unless the list is empty.
+int search_analyze(SearchContext* ctx, uint64_t player_board, uint64_t opponent_board, RootMoveList* moves);
+
+// Safe to call from another thread while a search is running.
+void search_request_stop(SearchContext* ctx);
+
+#endif /* SEARCH_H */
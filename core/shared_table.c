@@ -0,0 +1,232 @@
+// core/shared_table.c
+
+#include "shared_table.h"
+#include "large_alloc.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+
+OthelloStatus shared_table_create(const char* name, size_t size_mb, char* error, size_t error_size) {
+    snprintf(error, error_size, "Shared tables need POSIX shared memory.");
+    return OTHELLO_ERROR_INVALID_ARGUMENT;
+}
+
+OthelloStatus shared_table_destroy(const char* name, char* error, size_t error_size) {
+    snprintf(error, error_size, "Shared tables need POSIX shared memory.");
+    return OTHELLO_ERROR_INVALID_ARGUMENT;
+}
+
+SharedTable* shared_table_attach(const char* name, char* error, size_t error_size) {
+    snprintf(error, error_size, "Shared tables need POSIX shared memory.");
+    return NULL;
+}
+
+void shared_table_release(SharedTable* table) {
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The segment starts with one cache line of header, then the entries.
+typedef struct {
+    char magic[16];
+    uint64_t mask;
+    uint64_t reserved[5];
+} SharedTableHeader;
+
+// Tables this process has mapped. A mapping stays cached after its last
+// release so the next game attaches without touching the kernel's page
+// tables again; it is only unmapped once released and known to be replaced
+// or destroyed.
+static SharedTable* attached = NULL;
+static pthread_mutex_t attached_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// POSIX names are "/name"; the slash is added when missing.
+static bool segment_name(const char* name, char* out, size_t out_size, char* error, size_t error_size) {
+    if (name == NULL || name[0] == '\0' || strchr(name + 1, '/') != NULL ||
+        snprintf(out, out_size, "%s%s", name[0] == '/' ? "" : "/", name) >= (int)out_size) {
+        snprintf(error, error_size, "Invalid shared table name '%s'.", name ? name : "");
+        return false;
+    }
+    return true;
+}
+
+OthelloStatus shared_table_create(const char* name, size_t size_mb, char* error, size_t error_size) {
+    char path[256];
+    if (!segment_name(name, path, sizeof(path), error, error_size)) {
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t entries = ((uint64_t)size_mb << 20) / sizeof(SharedTableEntry);
+    if (entries == 0) {
+        snprintf(error, error_size, "size_mb must be at least 1.");
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+    while (entries & (entries - 1)) {
+        entries &= entries - 1;
+    }
+
+    int fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        snprintf(error, error_size, "Cannot create shared table '%s': %s.", path, strerror(errno));
+        return OTHELLO_ERROR_IO;
+    }
+
+    size_t size = sizeof(SharedTableHeader) + entries * sizeof(SharedTableEntry);
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (base == MAP_FAILED) {
+        snprintf(error, error_size, "Cannot size shared table '%s': %s.", path, strerror(errno));
+        close(fd);
+        shm_unlink(path);
+        return OTHELLO_ERROR_OUT_OF_MEMORY;
+    }
+    close(fd);
+
+    // The table is probed from every socket, so its pages are interleaved
+    // over the NUMA nodes; the policy stays with the segment for every later
+    // fault, whichever process takes it.
+    large_advise(base, size, LARGE_ALLOC_HUGE_PAGES | LARGE_ALLOC_INTERLEAVE);
+
+    // ftruncate zero-fills, so only the header needs writing.
+    SharedTableHeader* header = (SharedTableHeader*)base;
+    header->mask = entries - 1;
+    memcpy(header->magic, SHARED_TABLE_MAGIC, sizeof(SHARED_TABLE_MAGIC));
+    munmap(base, size);
+    return OTHELLO_OK;
+}
+
+static void unmap_table(SharedTable* table) {
+    SharedTable** link = &attached;
+    while (*link != table) {
+        link = &(*link)->next;
+    }
+    *link = table->next;
+    munmap(table->base, table->size);
+    free(table);
+}
+
+OthelloStatus shared_table_destroy(const char* name, char* error, size_t error_size) {
+    char path[256];
+    if (!segment_name(name, path, sizeof(path), error, error_size)) {
+        return OTHELLO_ERROR_INVALID_ARGUMENT;
+    }
+    if (shm_unlink(path) != 0) {
+        snprintf(error, error_size, "Cannot destroy shared table '%s': %s.", path, strerror(errno));
+        return OTHELLO_ERROR_IO;
+    }
+
+    pthread_mutex_lock(&attached_lock);
+    SharedTable* table = attached;
+    while (table != NULL) {
+        SharedTable* next = table->next;
+        if (strcmp(table->name, path) == 0) {
+            table->unlinked = true;
+            if (table->references == 0) {
+                unmap_table(table);
+            }
+        }
+        table = next;
+    }
+    pthread_mutex_unlock(&attached_lock);
+    return OTHELLO_OK;
+}
+
+SharedTable* shared_table_attach(const char* name, char* error, size_t error_size) {
+    char path[256];
+    if (!segment_name(name, path, sizeof(path), error, error_size)) {
+        return NULL;
+    }
+
+    int fd = shm_open(path, O_RDWR, 0);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        snprintf(error, error_size, "Cannot open shared table '%s': %s.", path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return NULL;
+    }
+
+    pthread_mutex_lock(&attached_lock);
+
+    // A cached mapping is reused unless the name now refers to a new segment.
+    SharedTable* table = attached;
+    while (table != NULL) {
+        SharedTable* next = table->next;
+        if (!table->unlinked && strcmp(table->name, path) == 0) {
+            if (table->device == (uint64_t)info.st_dev && table->inode == (uint64_t)info.st_ino) {
+                table->references++;
+                pthread_mutex_unlock(&attached_lock);
+                close(fd);
+                return table;
+            }
+            table->unlinked = true;
+            if (table->references == 0) {
+                unmap_table(table);
+            }
+        }
+        table = next;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* base = size >= sizeof(SharedTableHeader) ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    const SharedTableHeader* header = (const SharedTableHeader*)base;
+    if (base == MAP_FAILED || memcmp(header->magic, SHARED_TABLE_MAGIC, sizeof(SHARED_TABLE_MAGIC)) != 0 ||
+        sizeof(SharedTableHeader) + (header->mask + 1) * sizeof(SharedTableEntry) != size) {
+        pthread_mutex_unlock(&attached_lock);
+        if (base != MAP_FAILED) {
+            munmap(base, size);
+        }
+        snprintf(error, error_size, "'%s' is not a shared table.", path);
+        return NULL;
+    }
+
+    // Huge page advice belongs to the mapping, not the segment.
+    large_advise(base, size, LARGE_ALLOC_HUGE_PAGES);
+
+    table = (SharedTable*)calloc(1, sizeof(SharedTable));
+    if (table == NULL) {
+        pthread_mutex_unlock(&attached_lock);
+        munmap(base, size);
+        snprintf(error, error_size, "Out of memory.");
+        return NULL;
+    }
+    snprintf(table->name, sizeof(table->name), "%s", path);
+    table->entries = (volatile SharedTableEntry*)((char*)base + sizeof(SharedTableHeader));
+    table->mask = header->mask;
+    table->base = base;
+    table->size = size;
+    table->device = (uint64_t)info.st_dev;
+    table->inode = (uint64_t)info.st_ino;
+    table->references = 1;
+    table->next = attached;
+    attached = table;
+
+    pthread_mutex_unlock(&attached_lock);
+    return table;
+}
+
+void shared_table_release(SharedTable* table) {
+    if (table == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&attached_lock);
+    if (--table->references == 0 && table->unlinked) {
+        unmap_table(table);
+    }
+    pthread_mutex_unlock(&attached_lock);
+}
+
+#endif
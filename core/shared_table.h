@@ -0,0 +1,99 @@
+// core/shared_table.h
+
+#ifndef SHARED_TABLE_H
+#define SHARED_TABLE_H
+
+#include "othello_core.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A transposition table in a named POSIX shared-memory segment, read and
+// written by searches in every process on the host without locks. Each entry
+// stores its key XORed with its data, so an entry torn by two concurrent
+// writers no longer verifies and reads as a miss instead of a wrong score.
+//
+// data: bits 0-31 value, 32-39 remaining depth, 40-41 bound. Zero is never a
+// stored value, which keeps a fresh (zero-filled) segment empty.
+#define SHARED_TABLE_MAGIC "othello-tt 1"
+#define SHARED_TABLE_LOWER 1
+#define SHARED_TABLE_UPPER 2
+#define SHARED_TABLE_EXACT 3
+
+typedef struct {
+    uint64_t check;
+    uint64_t data;
+} SharedTableEntry;
+
+typedef struct SharedTable SharedTable;
+
+struct SharedTable {
+    volatile SharedTableEntry* entries;
+    uint64_t mask;
+    // Process-local bookkeeping; see shared_table.c.
+    char name[256];
+    void* base;
+    size_t size;
+    uint64_t device;
+    uint64_t inode;
+    int references;
+    bool unlinked;
+    SharedTable* next;
+};
+
+// Creates a zeroed table of size_mb megabytes (rounded down to a power of two
+// entries) under name. Fails if the name is already in use.
+OthelloStatus shared_table_create(const char* name, size_t size_mb, char* error, size_t error_size);
+
+// Removes the name; processes that still have the table attached keep their
+// mapping until they release it.
+OthelloStatus shared_table_destroy(const char* name, char* error, size_t error_size);
+
+// Maps the table for this process. Mappings are cached per process, so
+// attaching once per game costs a lookup rather than a fresh mmap. Returns
+// NULL with error set on failure.
+SharedTable* shared_table_attach(const char* name, char* error, size_t error_size);
+void shared_table_release(SharedTable* table);
+
+static inline uint64_t shared_table_key(uint64_t player_board, uint64_t opponent_board, uint64_t salt) {
+    uint64_t h = (player_board * 0x9E3779B97F4A7C15ULL) ^ ((opponent_board * 0xC2B2AE3D27D4EB4FULL) >> 1) ^ salt;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Returns true with *value set when the stored result decides the node.
+static inline bool shared_table_probe(const SharedTable* table, uint64_t key, int depth, int alpha, int beta, int* value) {
+    volatile const SharedTableEntry* entry = &table->entries[key & table->mask];
+    uint64_t data = entry->data;
+    if ((entry->check ^ data) != key || (int)((data >> 32) & 0xFF) < depth) {
+        return false;
+    }
+
+    int stored = (int)(int32_t)(uint32_t)data;
+    int bound = (int)((data >> 40) & 3);
+    if (bound == SHARED_TABLE_EXACT || (bound == SHARED_TABLE_LOWER && stored >= beta) ||
+        (bound == SHARED_TABLE_UPPER && stored <= alpha)) {
+        *value = stored;
+        return true;
+    }
+    return false;
+}
+
+// Fail-soft: a value outside the searched window is only a bound. A slot
+// holding a deeper result for the same position is kept.
+static inline void shared_table_store(SharedTable* table, uint64_t key, int depth, int alpha, int beta, int value) {
+    volatile SharedTableEntry* entry = &table->entries[key & table->mask];
+    uint64_t old = entry->data;
+    if ((entry->check ^ old) == key && (int)((old >> 32) & 0xFF) > depth) {
+        return;
+    }
+
+    uint64_t bound = value <= alpha ? SHARED_TABLE_UPPER : (value >= beta ? SHARED_TABLE_LOWER : SHARED_TABLE_EXACT);
+    uint64_t data = (uint64_t)(uint32_t)(int32_t)value | ((uint64_t)(depth & 0xFF) << 32) | (bound << 40);
+    entry->check = key ^ data;
+    entry->data = data;
+}
+
+#endif /* SHARED_TABLE_H */
@@ -0,0 +1,36 @@
+// core/timeman.c
+
+#include "timeman.h"
+
+void time_budget_init(TimeBudget* budget, uint64_t time_left_ns, uint64_t increment_ns, int empties, uint64_t overhead_ns) {
+    uint64_t usable = time_left_ns > overhead_ns ? time_left_ns - overhead_ns : 0;
+    // Each side has about half the empties left to play.
+    uint64_t moves_left = empties > 1 ? (uint64_t)(empties + 1) / 2 : 1;
+
+    uint64_t soft = usable / moves_left + increment_ns * 3 / 4;
+    uint64_t hard = soft * 4;
+    // Keep something for the rest of the game unless this is the last move.
+    uint64_t cap = moves_left > 1 ? usable / 2 : usable;
+    if (hard > cap) {
+        hard = cap;
+    }
+    if (soft > hard) {
+        soft = hard;
+    }
+
+    budget->soft_ns = soft;
+    // A zero deadline would mean no deadline at all.
+    budget->hard_ns = hard > 0 ? hard : 1;
+}
+
+uint64_t time_budget_allowance(const TimeBudget* budget, int stable_iterations) {
+    uint64_t allowance;
+    if (stable_iterations == 0) {
+        allowance = budget->soft_ns * 2;
+    } else if (stable_iterations >= 3) {
+        allowance = budget->soft_ns / 2;
+    } else {
+        allowance = budget->soft_ns;
+    }
+    return allowance < budget->hard_ns ? allowance : budget->hard_ns;
+}
@@ -0,0 +1,24 @@
+// core/timeman.h
+
+#ifndef TIMEMAN_H
+#define TIMEMAN_H
+
+#include <stdint.h>
+
+// How long one move may think under a match clock. The search aims for
+// soft_ns, stretching or cutting it by how settled the best move is, and is
+// aborted at hard_ns.
+typedef struct {
+    uint64_t soft_ns;
+    uint64_t hard_ns;
+} TimeBudget;
+
+// time_left_ns and increment_ns are the mover's clock; overhead_ns is kept back
+// for the time spent outside the search (move transport, clock reading).
+void time_budget_init(TimeBudget* budget, uint64_t time_left_ns, uint64_t increment_ns, int empties, uint64_t overhead_ns);
+
+// Allowance after an iteration whose best move was the same as in the
+// previous stable_iterations iterations (0 when it just changed).
+uint64_t time_budget_allowance(const TimeBudget* budget, int stable_iterations);
+
+#endif /* TIMEMAN_H */
@@ -0,0 +1,360 @@
+// engine/nboard.c
+//
+// Native engine speaking the NBoard protocol over stdin/stdout. Supported
+// commands: nboard, set depth, set game, move, go, hint, ping and quit. The
+// engine has no book and no contempt, so learn, analyze, set contempt and any
+// other command are ignored. As extensions, "go" and "hint" accept optional
+// "depth N" and "time MS" limits, "set time MS" sets a default time limit, and
+// "stop" ends a running search early with its best result so far.
+
+#include "board.h"
+#include "search.h"
+#include "parallel.h"
+#include "timer.h"
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENGINE_NAME "othello-project"
+#define LINE_SIZE 8192
+#define MAX_SEARCH_DEPTH 60
+
+typedef enum {
+    JOB_GO,
+    JOB_HINT
+} JobKind;
+
+typedef struct {
+    uint64_t black_board;
+    uint64_t white_board;
+    bool white_to_move;
+} GamePosition;
+
+typedef struct {
+    SearchContext search;
+    GamePosition position;
+    int depth;
+    int time_limit_ms;
+    const char* evaluator;
+
+    ParallelThread worker;
+    bool searching;
+    JobKind job;
+    int hint_count;
+    int job_depth;
+    int job_time_ms;
+} Engine;
+
+static void format_square(int move, char* out) {
+    if (move < 0) {
+        strcpy(out, "PA");
+        return;
+    }
+    out[0] = (char)('a' + move % BOARD_SIZE);
+    out[1] = (char)('1' + move / BOARD_SIZE);
+    out[2] = '\0';
+}
+
+static int parse_square(const char* text) {
+    if (strncmp(text, "PA", 2) == 0 || strncmp(text, "pa", 2) == 0 || strncmp(text, "pass", 4) == 0) {
+        return -1;
+    }
+    int col = tolower((unsigned char)text[0]) - 'a';
+    int row = text[1] - '1';
+    if (col < 0 || col >= BOARD_SIZE || row < 0 || row >= BOARD_SIZE) {
+        return -2;
+    }
+    return row * BOARD_SIZE + col;
+}
+
+static void position_reset(GamePosition* position) {
+    position->black_board = (1ULL << 28) | (1ULL << 35);
+    position->white_board = (1ULL << 27) | (1ULL << 36);
+    position->white_to_move = false;
+}
+
+static void position_boards(const GamePosition* position, uint64_t* player, uint64_t* opponent) {
+    *player = position->white_to_move ? position->white_board : position->black_board;
+    *opponent = position->white_to_move ? position->black_board : position->white_board;
+}
+
+// Plays move (-1 for a pass) for the side to move; returns false if illegal.
+static bool position_play(GamePosition* position, int move) {
+    uint64_t player, opponent;
+    position_boards(position, &player, &opponent);
+
+    if (move >= 0) {
+        if (!((get_moves_mask(player, opponent) >> move) & 1ULL)) {
+            return false;
+        }
+        uint64_t flips = get_flip_mask(move, player, opponent);
+        player |= flips | (1ULL << move);
+        opponent &= ~flips;
+    }
+
+    position->black_board = position->white_to_move ? opponent : player;
+    position->white_board = position->white_to_move ? player : opponent;
+    position->white_to_move = !position->white_to_move;
+    return true;
+}
+
+// Parses the board and moves of a GGF game record such as
+// (;GM[Othello]BO[8 ---------------------------O*------*O--------------------------- *]B[d3]W[c5];)
+static bool position_from_ggf(GamePosition* position, const char* ggf) {
+    position_reset(position);
+
+    const char* board = strstr(ggf, "BO[");
+    if (board != NULL) {
+        board += 3;
+        while (isdigit((unsigned char)*board) || *board == ' ') {
+            board++;
+        }
+        position->black_board = 0;
+        position->white_board = 0;
+        for (int sq = 0; sq < 64; sq++, board++) {
+            while (*board == ' ') {
+                board++;
+            }
+            if (*board == '*') {
+                position->black_board |= 1ULL << sq;
+            } else if (*board == 'O') {
+                position->white_board |= 1ULL << sq;
+            } else if (*board != '-') {
+                return false;
+            }
+        }
+        while (*board == ' ') {
+            board++;
+        }
+        position->white_to_move = *board == 'O';
+    }
+
+    for (const char* cursor = ggf; (cursor = strchr(cursor, '[')) != NULL; cursor++) {
+        if (cursor == ggf) {
+            continue;
+        }
+        char tag = cursor[-1];
+        if ((tag != 'B' && tag != 'W') || (cursor - ggf >= 2 && isupper((unsigned char)cursor[-2]))) {
+            continue;
+        }
+        // A tag for the side not on move means the other side passed implicitly.
+        if ((tag == 'W') != position->white_to_move) {
+            position_play(position, -1);
+        }
+        int move = parse_square(cursor + 1);
+        if (move == -2 || !position_play(position, move)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void send(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stdout, format, args);
+    va_end(args);
+    fputc('\n', stdout);
+    fflush(stdout);
+}
+
+static void search_job(void* arg) {
+    Engine* engine = (Engine*)arg;
+    uint64_t player, opponent;
+    position_boards(&engine->position, &player, &opponent);
+
+    engine->search.iter = 0;
+    engine->search.depth_limit = engine->job_depth;
+    engine->search.time_limit_ms = engine->job_time_ms;
+
+    uint64_t start = monotonic_ns();
+    RootMoveList root_moves;
+    int score = search_iterative(&engine->search, player, opponent, &root_moves);
+    double seconds = (double)(monotonic_ns() - start) / 1e9;
+
+    if (engine->job == JOB_GO) {
+        char square[4];
+        int move = root_moves.best_index >= 0 ? root_moves.moves[root_moves.best_index].move : -1;
+        format_square(move, square);
+        send("nodestats %llu %.3f", (unsigned long long)engine->search.iter, seconds);
+        if (move < 0) {
+            send("=== PA");
+        } else {
+            send("=== %s/%d/%.3f", square, score, seconds);
+        }
+        return;
+    }
+
+    send("status Analyzing");
+    // Report the best moves first, up to the requested count.
+    bool reported[MAX_ROOT_MOVES] = {false};
+    for (int n = 0; n < engine->hint_count && n < root_moves.count; n++) {
+        int best = -1;
+        for (int i = 0; i < root_moves.count; i++) {
+            if (!reported[i] && (best < 0 || root_moves.moves[i].score > root_moves.moves[best].score)) {
+                best = i;
+            }
+        }
+        reported[best] = true;
+        char square[4];
+        format_square(root_moves.moves[best].move, square);
+        send("search %s %d 0 %d", square, root_moves.moves[best].score, root_moves.depth);
+    }
+    if (root_moves.count == 0) {
+        send("search PA 0 0 %d", root_moves.depth);
+    }
+    send("status");
+}
+
+static void finish_search(Engine* engine) {
+    if (engine->searching) {
+        parallel_thread_join(&engine->worker);
+        engine->searching = false;
+    }
+}
+
+static void start_search(Engine* engine, JobKind job, char* args) {
+    engine->job = job;
+    engine->job_depth = engine->depth;
+    engine->job_time_ms = engine->time_limit_ms;
+    engine->hint_count = 1;
+
+    char* token = strtok(args, " \t");
+    if (job == JOB_HINT && token != NULL && isdigit((unsigned char)token[0])) {
+        engine->hint_count = atoi(token);
+        token = strtok(NULL, " \t");
+    }
+    while (token != NULL) {
+        char* value = strtok(NULL, " \t");
+        if (value == NULL) {
+            break;
+        }
+        if (strcmp(token, "depth") == 0) {
+            engine->job_depth = atoi(value);
+        } else if (strcmp(token, "time") == 0) {
+            engine->job_time_ms = atoi(value);
+        }
+        token = strtok(NULL, " \t");
+    }
+    if (engine->job_depth < 1) {
+        engine->job_depth = 1;
+    } else if (engine->job_depth > MAX_SEARCH_DEPTH) {
+        engine->job_depth = MAX_SEARCH_DEPTH;
+    }
+
+    engine->search.stop_requested = 0;
+    if (parallel_thread_start(&engine->worker, search_job, engine) == 0) {
+        engine->searching = true;
+    } else {
+        search_job(engine);
+    }
+}
+
+static bool configure_search(Engine* engine) {
+    OthelloSearchOptions options;
+    othello_search_options_init(&options);
+    // The context is sized for the deepest search allowed, per-request limits only lower it.
+    options.max_depth = MAX_SEARCH_DEPTH;
+    options.evaluator = engine->evaluator;
+    options.nnue_weights = getenv("OTHELLO_NNUE_WEIGHTS");
+    options.mpc_params = getenv("OTHELLO_MPC_PARAMS");
+    options.shared_table = getenv("OTHELLO_SHARED_TABLE");
+    options.eval_params = getenv("OTHELLO_EVAL_PARAMS");
+    options.eval_cache_mb = getenv("OTHELLO_EVAL_CACHE_MB") ? atoi(getenv("OTHELLO_EVAL_CACHE_MB")) : 0;
+
+    SearchContext search;
+    char error[256];
+    if (search_context_init(&search, &options, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        return false;
+    }
+    search_context_free(&engine->search);
+    engine->search = search;
+    return true;
+}
+
+static bool handle_command(Engine* engine, char* line) {
+    char* command = strtok(line, " \t");
+    if (command == NULL) {
+        return true;
+    }
+    char* rest = strtok(NULL, "");
+    if (rest == NULL) {
+        rest = "";
+    }
+
+    if (strcmp(command, "stop") == 0) {
+        if (engine->searching) {
+            search_request_stop(&engine->search);
+        }
+        finish_search(engine);
+        return true;
+    }
+
+    // Every other command acts on a quiet engine, like a GUI that waits for pong.
+    finish_search(engine);
+
+    if (strcmp(command, "quit") == 0) {
+        return false;
+    } else if (strcmp(command, "nboard") == 0) {
+        send("set myname " ENGINE_NAME);
+    } else if (strcmp(command, "ping") == 0) {
+        send("pong %s", rest);
+    } else if (strcmp(command, "set") == 0) {
+        char* key = strtok(rest, " \t");
+        char* value = strtok(NULL, "");
+        if (key == NULL || value == NULL) {
+            return true;
+        }
+        if (strcmp(key, "depth") == 0) {
+            engine->depth = atoi(value) > 0 ? atoi(value) : 1;
+            if (engine->depth > MAX_SEARCH_DEPTH) {
+                engine->depth = MAX_SEARCH_DEPTH;
+            }
+        } else if (strcmp(key, "time") == 0) {
+            engine->time_limit_ms = atoi(value);
+        } else if (strcmp(key, "game") == 0) {
+            if (!position_from_ggf(&engine->position, value)) {
+                send("status Invalid game record");
+            }
+        }
+    } else if (strcmp(command, "move") == 0) {
+        int move = parse_square(rest);
+        if (move == -2 || !position_play(&engine->position, move)) {
+            send("status Illegal move %s", rest);
+        }
+    } else if (strcmp(command, "go") == 0) {
+        start_search(engine, JOB_GO, rest);
+    } else if (strcmp(command, "hint") == 0) {
+        start_search(engine, JOB_HINT, rest);
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Engine engine;
+    memset(&engine, 0, sizeof(engine));
+    engine.depth = 8;
+    engine.evaluator = argc > 1 ? argv[1] : "combined_evaluate";
+    position_reset(&engine.position);
+
+    if (!configure_search(&engine)) {
+        return 1;
+    }
+
+    char line[LINE_SIZE];
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (!handle_command(&engine, line)) {
+            break;
+        }
+    }
+
+    finish_search(&engine);
+    search_context_free(&engine.search);
+    return 0;
+}
@@ -0,0 +1,732 @@
+// engine/server.c
+//
+// Serves searches to many concurrent game sessions over a Unix socket or TCP
+// on localhost. Each connection is a session that sends one request per line:
+//
+//   go PLAYER OPPONENT [depth D] [time MS]
+//       Boards are hex bitboards seen from the side to move. The reply is
+//       "move SQUARE score S depth D nodes N wait_ms W search_ms T", with
+//       SQUARE "pass" when there is no legal move, or "busy" when the queue is
+//       full. time is the whole budget from the moment the request is read,
+//       so time spent queued shortens the search.
+//   stats
+//       Answered at once, ahead of the session's pending searches:
+//       "stats sessions S workers W busy B queued Q served N rejected R
+//       wait_p50 .. wait_p99 .. latency_p50 .. latency_p99 .. latency_max ..
+//       nodes N uptime_s U", times in milliseconds since the server started.
+//   quit
+//
+// Searches run on a fixed pool of native workers, each with its own search
+// context. Sessions with pending requests take turns: a worker serves one
+// request of the session at the head of the ready ring and puts the session
+// back at the tail, so a session that pipelines many requests cannot starve
+// the others, and replies to one session come back in request order.
+//
+//   othello_server [--socket PATH | --port N] [--threads T] [--evaluator NAME]
+//                  [--depth D] [--time MS] [--max-time MS] [--max-queue N]
+
+#include "board.h"
+#include "search.h"
+#include "parallel.h"
+#include "timer.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define LINE_SIZE 512
+#define MAX_SEARCH_DEPTH 60
+#define SESSION_QUEUE_LIMIT 64
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+// Log-linear in microseconds: 8 buckets per power of two.
+#define HISTOGRAM_BUCKETS 512
+
+typedef struct Request {
+    struct Request* next;
+    uint64_t player_board;
+    uint64_t opponent_board;
+    int depth;
+    int time_ms;
+    uint64_t received_ns;
+} Request;
+
+typedef struct Session {
+    int fd;
+    // One reference for the I/O thread while connected, one while the
+    // session is in the ready ring or being served.
+    int references;
+    bool closed;
+    bool scheduled;
+    Request* head;
+    Request* tail;
+    int pending;
+    struct Session* next_ready;
+    pthread_mutex_t write_lock;
+    char input[LINE_SIZE];
+    size_t input_length;
+} Session;
+
+typedef struct {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t total;
+    uint64_t max_us;
+} Histogram;
+
+typedef struct {
+    OthelloSearchOptions options;
+    int default_depth;
+    int default_time_ms;
+    int max_time_ms;
+    int max_queue;
+    int worker_count;
+
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    Session* ready_head;
+    Session* ready_tail;
+    bool stopping;
+
+    // Guarded by lock.
+    int session_count;
+    int busy;
+    int queued;
+    uint64_t served;
+    uint64_t rejected;
+    uint64_t nodes;
+    uint64_t start_ns;
+    Histogram wait;
+    Histogram latency;
+} Server;
+
+typedef struct {
+    Server* server;
+    SearchContext search;
+    ParallelThread thread;
+} Worker;
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_signal(int signal_number) {
+    (void)signal_number;
+    interrupted = 1;
+}
+
+static int histogram_bucket(uint64_t us) {
+    if (us < 8) {
+        return (int)us;
+    }
+    int exponent = 3;
+    while (us >> (exponent + 1)) {
+        exponent++;
+    }
+    return (exponent - 2) * 8 + (int)((us >> (exponent - 3)) & 7);
+}
+
+// Largest value that falls into bucket.
+static uint64_t histogram_bucket_limit(int bucket) {
+    if (bucket < 8) {
+        return (uint64_t)bucket;
+    }
+    int exponent = bucket / 8 + 2;
+    return ((uint64_t)(9 + bucket % 8) << (exponent - 3)) - 1;
+}
+
+static void histogram_add(Histogram* histogram, uint64_t us) {
+    histogram->counts[histogram_bucket(us)]++;
+    histogram->total++;
+    if (us > histogram->max_us) {
+        histogram->max_us = us;
+    }
+}
+
+static double histogram_percentile_ms(const Histogram* histogram, double fraction) {
+    if (histogram->total == 0) {
+        return 0.0;
+    }
+    uint64_t rank = (uint64_t)(fraction * (double)histogram->total + 0.999999);
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += histogram->counts[bucket];
+        if (seen >= rank) {
+            uint64_t limit = histogram_bucket_limit(bucket);
+            return (limit < histogram->max_us ? limit : histogram->max_us) / 1000.0;
+        }
+    }
+    return histogram->max_us / 1000.0;
+}
+
+static int format_square(int move, char* out) {
+    if (move < 0) {
+        return sprintf(out, "pass");
+    }
+    return sprintf(out, "%c%c", 'a' + move % BOARD_SIZE, '1' + move / BOARD_SIZE);
+}
+
+// A client that stops reading its replies is disconnected rather than allowed
+// to block a worker.
+static void session_send(Session* session, const char* text) {
+    size_t length = strlen(text);
+    pthread_mutex_lock(&session->write_lock);
+    while (length > 0 && !session->closed) {
+        ssize_t sent = send(session->fd, text, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            shutdown(session->fd, SHUT_RDWR);
+            break;
+        }
+        text += sent;
+        length -= (size_t)sent;
+    }
+    pthread_mutex_unlock(&session->write_lock);
+}
+
+static void session_drop_requests(Server* server, Session* session) {
+    while (session->head != NULL) {
+        Request* request = session->head;
+        session->head = request->next;
+        free(request);
+    }
+    session->tail = NULL;
+    server->queued -= session->pending;
+    session->pending = 0;
+}
+
+// Called with the lock held; returns true when the caller must free session.
+static bool session_release(Session* session) {
+    return --session->references == 0;
+}
+
+static void session_free(Session* session) {
+    close(session->fd);
+    pthread_mutex_destroy(&session->write_lock);
+    free(session);
+}
+
+static void push_ready(Server* server, Session* session) {
+    session->next_ready = NULL;
+    if (server->ready_tail != NULL) {
+        server->ready_tail->next_ready = session;
+    } else {
+        server->ready_head = session;
+    }
+    server->ready_tail = session;
+}
+
+static void serve_request(Worker* worker, Session* session, const Request* request) {
+    Server* server = worker->server;
+    SearchContext* search = &worker->search;
+
+    uint64_t start = monotonic_ns();
+    uint64_t waited_ns = start - request->received_ns;
+    int time_ms = 0;
+    if (request->time_ms > 0) {
+        // Whatever is left of the budget after queueing, but never nothing:
+        // a late move still beats no move.
+        int64_t left_ms = request->time_ms - (int64_t)(waited_ns / 1000000);
+        time_ms = left_ms > 1 ? (int)left_ms : 1;
+    }
+
+    search->iter = 0;
+    search->depth_limit = request->depth;
+    search->time_limit_ms = time_ms;
+    RootMoveList root_moves;
+    int score = search_iterative(search, request->player_board, request->opponent_board, &root_moves);
+    uint64_t end = monotonic_ns();
+
+    int move = root_moves.best_index >= 0 ? root_moves.moves[root_moves.best_index].move : -1;
+    char square[8];
+    format_square(move, square);
+    char reply[LINE_SIZE];
+    snprintf(reply, sizeof(reply), "move %s score %d depth %d nodes %llu wait_ms %.3f search_ms %.3f\n", square,
+             move < 0 ? 0 : score, root_moves.depth, (unsigned long long)search->iter, waited_ns / 1e6,
+             (end - start) / 1e6);
+    session_send(session, reply);
+
+    pthread_mutex_lock(&server->lock);
+    server->served++;
+    server->nodes += search->iter;
+    histogram_add(&server->wait, waited_ns / 1000);
+    histogram_add(&server->latency, (end - request->received_ns) / 1000);
+    pthread_mutex_unlock(&server->lock);
+}
+
+static void worker_run(void* arg) {
+    Worker* worker = (Worker*)arg;
+    Server* server = worker->server;
+
+    pthread_mutex_lock(&server->lock);
+    for (;;) {
+        while (!server->stopping && server->ready_head == NULL) {
+            pthread_cond_wait(&server->ready, &server->lock);
+        }
+        if (server->stopping) {
+            break;
+        }
+
+        Session* session = server->ready_head;
+        server->ready_head = session->next_ready;
+        if (server->ready_head == NULL) {
+            server->ready_tail = NULL;
+        }
+
+        Request* request = session->head;
+        if (request != NULL) {
+            session->head = request->next;
+            if (session->head == NULL) {
+                session->tail = NULL;
+            }
+            session->pending--;
+            server->queued--;
+            server->busy++;
+            // Cleared under the lock, before shutdown can set stopping and
+            // stop the search, so that stop is never overwritten.
+            worker->search.stop_requested = 0;
+            pthread_mutex_unlock(&server->lock);
+
+            serve_request(worker, session, request);
+            free(request);
+
+            pthread_mutex_lock(&server->lock);
+            server->busy--;
+        }
+
+        // Back to the end of the ring while it has more to do.
+        if (session->head != NULL && !session->closed) {
+            push_ready(server, session);
+            pthread_cond_signal(&server->ready);
+        } else {
+            session->scheduled = false;
+            if (session_release(session)) {
+                session_free(session);
+            }
+        }
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+static void send_stats(Server* server, Session* session) {
+    char reply[LINE_SIZE];
+    pthread_mutex_lock(&server->lock);
+    snprintf(reply, sizeof(reply),
+             "stats sessions %d workers %d busy %d queued %d served %llu rejected %llu "
+             "wait_p50 %.3f wait_p99 %.3f latency_p50 %.3f latency_p99 %.3f latency_max %.3f "
+             "nodes %llu uptime_s %.3f\n",
+             server->session_count, server->worker_count, server->busy, server->queued,
+             (unsigned long long)server->served, (unsigned long long)server->rejected,
+             histogram_percentile_ms(&server->wait, 0.50), histogram_percentile_ms(&server->wait, 0.99),
+             histogram_percentile_ms(&server->latency, 0.50), histogram_percentile_ms(&server->latency, 0.99),
+             server->latency.max_us / 1000.0, (unsigned long long)server->nodes,
+             (monotonic_ns() - server->start_ns) / 1e9);
+    pthread_mutex_unlock(&server->lock);
+    session_send(session, reply);
+}
+
+static bool parse_board(const char* text, uint64_t* board) {
+    char* end;
+    errno = 0;
+    *board = strtoull(text, &end, 16);
+    return errno == 0 && end != text && *end == '\0';
+}
+
+static void queue_search(Server* server, Session* session, char* args, uint64_t received_ns) {
+    Request request;
+    memset(&request, 0, sizeof(request));
+    request.depth = server->default_depth;
+    request.time_ms = server->default_time_ms;
+    request.received_ns = received_ns;
+
+    char* player = strtok(args, " \t");
+    char* opponent = strtok(NULL, " \t");
+    if (player == NULL || opponent == NULL || !parse_board(player, &request.player_board) ||
+        !parse_board(opponent, &request.opponent_board) || (request.player_board & request.opponent_board)) {
+        session_send(session, "error invalid position\n");
+        return;
+    }
+    for (char* key = strtok(NULL, " \t"); key != NULL; key = strtok(NULL, " \t")) {
+        char* value = strtok(NULL, " \t");
+        if (value == NULL || (strcmp(key, "depth") != 0 && strcmp(key, "time") != 0)) {
+            session_send(session, "error invalid limit\n");
+            return;
+        }
+        if (strcmp(key, "depth") == 0) {
+            request.depth = atoi(value);
+        } else {
+            request.time_ms = atoi(value);
+        }
+    }
+    if (request.depth < 1) {
+        request.depth = 1;
+    } else if (request.depth > MAX_SEARCH_DEPTH) {
+        request.depth = MAX_SEARCH_DEPTH;
+    }
+    if (request.time_ms < 0) {
+        request.time_ms = 0;
+    }
+    if (server->max_time_ms > 0 && (request.time_ms == 0 || request.time_ms > server->max_time_ms)) {
+        request.time_ms = server->max_time_ms;
+    }
+
+    Request* queued = (Request*)malloc(sizeof(Request));
+    if (queued == NULL) {
+        session_send(session, "error out of memory\n");
+        return;
+    }
+    *queued = request;
+
+    pthread_mutex_lock(&server->lock);
+    if (server->queued >= server->max_queue || session->pending >= SESSION_QUEUE_LIMIT) {
+        server->rejected++;
+        pthread_mutex_unlock(&server->lock);
+        free(queued);
+        session_send(session, "busy\n");
+        return;
+    }
+    if (session->tail != NULL) {
+        session->tail->next = queued;
+    } else {
+        session->head = queued;
+    }
+    session->tail = queued;
+    session->pending++;
+    server->queued++;
+    if (!session->scheduled) {
+        session->scheduled = true;
+        session->references++;
+        push_ready(server, session);
+        pthread_cond_signal(&server->ready);
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+// Returns false when the session asked to quit.
+static bool handle_line(Server* server, Session* session, char* line, uint64_t received_ns) {
+    char* command = strtok(line, " \t");
+    if (command == NULL) {
+        return true;
+    }
+    char* rest = strtok(NULL, "");
+    if (rest == NULL) {
+        rest = "";
+    }
+
+    if (strcmp(command, "go") == 0) {
+        queue_search(server, session, rest, received_ns);
+    } else if (strcmp(command, "stats") == 0) {
+        send_stats(server, session);
+    } else if (strcmp(command, "quit") == 0) {
+        return false;
+    } else {
+        session_send(session, "error unknown command\n");
+    }
+    return true;
+}
+
+// Reads what is available; returns false once the session is finished.
+static bool session_read(Server* server, Session* session) {
+    ssize_t received = recv(session->fd, session->input + session->input_length,
+                            sizeof(session->input) - session->input_length - 1, 0);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return true;
+    }
+    if (received <= 0) {
+        return false;
+    }
+    uint64_t received_ns = monotonic_ns();
+    session->input_length += (size_t)received;
+    session->input[session->input_length] = '\0';
+
+    char* line = session->input;
+    char* newline;
+    while ((newline = strchr(line, '\n')) != NULL) {
+        *newline = '\0';
+        if (newline > line && newline[-1] == '\r') {
+            newline[-1] = '\0';
+        }
+        if (!handle_line(server, session, line, received_ns)) {
+            return false;
+        }
+        line = newline + 1;
+    }
+    session->input_length -= (size_t)(line - session->input);
+    memmove(session->input, line, session->input_length);
+    if (session->input_length == sizeof(session->input) - 1) {
+        session_send(session, "error line too long\n");
+        return false;
+    }
+    return true;
+}
+
+static void session_close(Server* server, Session* session) {
+    pthread_mutex_lock(&server->lock);
+    pthread_mutex_lock(&session->write_lock);
+    session->closed = true;
+    pthread_mutex_unlock(&session->write_lock);
+    // The request a worker is serving finishes; the rest are dropped.
+    session_drop_requests(server, session);
+    server->session_count--;
+    bool last = session_release(session);
+    pthread_mutex_unlock(&server->lock);
+    if (last) {
+        session_free(session);
+    }
+}
+
+static int listen_socket(const char* socket_path, int port) {
+    int fd;
+    if (socket_path != NULL) {
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (strlen(socket_path) >= sizeof(address.sun_path)) {
+            fprintf(stderr, "Socket path '%s' is too long.\n", socket_path);
+            return -1;
+        }
+        strcpy(address.sun_path, socket_path);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(socket_path);
+        if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+            fprintf(stderr, "Cannot bind '%s': %s.\n", socket_path, strerror(errno));
+            return -1;
+        }
+    } else {
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((unsigned short)port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        if (fd >= 0) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+        if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+            fprintf(stderr, "Cannot bind 127.0.0.1:%d: %s.\n", port, strerror(errno));
+            return -1;
+        }
+    }
+    if (listen(fd, 128) != 0) {
+        fprintf(stderr, "Cannot listen: %s.\n", strerror(errno));
+        return -1;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    return fd;
+}
+
+static Session* accept_session(Server* server, int listener, bool tcp) {
+    int fd = accept(listener, NULL, NULL);
+    if (fd < 0) {
+        return NULL;
+    }
+    Session* session = (Session*)calloc(1, sizeof(Session));
+    if (session == NULL) {
+        close(fd);
+        return NULL;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    if (tcp) {
+        int nodelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+    session->fd = fd;
+    session->references = 1;
+    pthread_mutex_init(&session->write_lock, NULL);
+
+    pthread_mutex_lock(&server->lock);
+    server->session_count++;
+    pthread_mutex_unlock(&server->lock);
+    return session;
+}
+
+// Polls the listener and every session until interrupted.
+static void serve(Server* server, int listener, bool tcp) {
+    int capacity = 64;
+    int count = 0;
+    Session** sessions = (Session**)malloc(sizeof(Session*) * capacity);
+    struct pollfd* fds = (struct pollfd*)malloc(sizeof(struct pollfd) * (capacity + 1));
+    if (sessions == NULL || fds == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        free(sessions);
+        free(fds);
+        return;
+    }
+
+    while (!interrupted) {
+        fds[0].fd = listener;
+        fds[0].events = POLLIN;
+        for (int i = 0; i < count; i++) {
+            fds[i + 1].fd = sessions[i]->fd;
+            fds[i + 1].events = POLLIN;
+        }
+        if (poll(fds, (nfds_t)(count + 1), -1) < 0) {
+            continue;
+        }
+
+        for (int i = count - 1; i >= 0; i--) {
+            if (fds[i + 1].revents && !session_read(server, sessions[i])) {
+                session_close(server, sessions[i]);
+                sessions[i] = sessions[--count];
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            Session* session;
+            while ((session = accept_session(server, listener, tcp)) != NULL) {
+                if (count == capacity) {
+                    capacity *= 2;
+                    Session** grown = (Session**)realloc(sessions, sizeof(Session*) * capacity);
+                    struct pollfd* grown_fds = (struct pollfd*)realloc(fds, sizeof(struct pollfd) * (capacity + 1));
+                    if (grown != NULL) {
+                        sessions = grown;
+                    }
+                    if (grown_fds != NULL) {
+                        fds = grown_fds;
+                    }
+                    if (grown == NULL || grown_fds == NULL) {
+                        capacity /= 2;
+                        session_close(server, session);
+                        break;
+                    }
+                }
+                sessions[count++] = session;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        session_close(server, sessions[i]);
+    }
+    free(sessions);
+    free(fds);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: othello_server [--socket PATH | --port N] [--threads T] [--evaluator NAME] "
+                    "[--depth D] [--time MS] [--max-time MS] [--max-queue N]\n");
+}
+
+int main(int argc, char** argv) {
+    Server server;
+    memset(&server, 0, sizeof(server));
+    othello_search_options_init(&server.options);
+    // Contexts are sized for the deepest search allowed, requests only lower it.
+    server.options.max_depth = MAX_SEARCH_DEPTH;
+    server.options.evaluator = "combined_evaluate";
+    server.options.nnue_weights = getenv("OTHELLO_NNUE_WEIGHTS");
+    server.options.mpc_params = getenv("OTHELLO_MPC_PARAMS");
+    server.options.shared_table = getenv("OTHELLO_SHARED_TABLE");
+    server.options.eval_params = getenv("OTHELLO_EVAL_PARAMS");
+    server.options.eval_cache_mb = getenv("OTHELLO_EVAL_CACHE_MB") ? atoi(getenv("OTHELLO_EVAL_CACHE_MB")) : 0;
+    server.default_depth = 8;
+    server.max_queue = 1024;
+
+    const char* socket_path = NULL;
+    int port = 4040;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL) {
+            usage();
+            return 2;
+        }
+        if (strcmp(argv[i], "--socket") == 0) {
+            socket_path = value;
+        } else if (strcmp(argv[i], "--port") == 0) {
+            port = atoi(value);
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            threads = atoi(value);
+        } else if (strcmp(argv[i], "--evaluator") == 0) {
+            server.options.evaluator = value;
+        } else if (strcmp(argv[i], "--depth") == 0) {
+            server.default_depth = atoi(value);
+        } else if (strcmp(argv[i], "--time") == 0) {
+            server.default_time_ms = atoi(value);
+        } else if (strcmp(argv[i], "--max-time") == 0) {
+            server.max_time_ms = atoi(value);
+        } else if (strcmp(argv[i], "--max-queue") == 0) {
+            server.max_queue = atoi(value);
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+    if (server.default_depth < 1 || server.default_depth > MAX_SEARCH_DEPTH || server.max_queue < 1 ||
+        (socket_path == NULL && (port <= 0 || port > 65535))) {
+        usage();
+        return 2;
+    }
+    server.worker_count = threads > 0 ? threads : default_thread_count();
+
+    Worker* workers = (Worker*)calloc(server.worker_count, sizeof(Worker));
+    if (workers == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+    for (int i = 0; i < server.worker_count; i++) {
+        char error[256];
+        workers[i].server = &server;
+        if (search_context_init(&workers[i].search, &server.options, error, sizeof(error)) != OTHELLO_OK) {
+            fprintf(stderr, "%s\n", error);
+            return 1;
+        }
+    }
+
+    int listener = listen_socket(socket_path, port);
+    if (listener < 0) {
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.ready, NULL);
+    server.start_ns = monotonic_ns();
+    for (int i = 0; i < server.worker_count; i++) {
+        if (parallel_thread_start(&workers[i].thread, worker_run, &workers[i]) != 0) {
+            fprintf(stderr, "Cannot start worker threads.\n");
+            return 1;
+        }
+    }
+
+    if (socket_path != NULL) {
+        fprintf(stderr, "Listening on %s with %d workers.\n", socket_path, server.worker_count);
+    } else {
+        fprintf(stderr, "Listening on 127.0.0.1:%d with %d workers.\n", port, server.worker_count);
+    }
+    serve(&server, listener, socket_path == NULL);
+
+    pthread_mutex_lock(&server.lock);
+    server.stopping = true;
+    pthread_cond_broadcast(&server.ready);
+    pthread_mutex_unlock(&server.lock);
+    for (int i = 0; i < server.worker_count; i++) {
+        search_request_stop(&workers[i].search);
+        parallel_thread_join(&workers[i].thread);
+        search_context_free(&workers[i].search);
+    }
+    close(listener);
+    if (socket_path != NULL) {
+        unlink(socket_path);
+    }
+    free(workers);
+    return 0;
+}
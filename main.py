@@ -1,84 +1,140 @@
 import players
 import othello
+import os
 import time
 import argparse
-import pandas as pd
 from concurrent.futures import ProcessPoolExecutor, as_completed
 from tqdm import tqdm
 from collections import defaultdict
-from openpyxl import Workbook
-from openpyxl.styles import Alignment, Font
+from results import ResultsWriter, clock_setting, read_rows, summarize_games
 
+PHASES = ("opening", "midgame", "endgame")
+# Timing CSV column suffix -> "Move Latency" sheet column, so the sheet can be
+# rebuilt from the CSV after a resumed run.
+LATENCY_COLUMNS = {
+    "moves": "Moves", "p50_ms": "p50 (ms)", "p90_ms": "p90 (ms)", "p99_ms": "p99 (ms)",
+    "max_ms": "Max (ms)", "p99_nodes": "p99 Nodes", "mean_legal_moves": "Mean Legal Moves",
+}
+TIMING_FIELDS = ["evaluation", "depth", "seed", "time_s"] + [
+    f"{phase}_{suffix}" for phase in PHASES for suffix in LATENCY_COLUMNS
+]
 
-def play_single_game(black_eval, white_eval, depth):
+
+def play_single_game(black_eval, white_eval, depth, clock=None, seed=None, game_index=0, shared_table=None):
     if black_eval == "random_player":
         black_player = players.RandomPlayer()
     else:
         black_player = players.MiniMaxPlayer(
-            max_depth=depth, evaluation_strategy=black_eval, debug=False
+            max_depth=depth, evaluation_strategy=black_eval, debug=False, shared_table=shared_table
         )
 
     if white_eval == "random_player":
         white_player = players.RandomPlayer()
     else:
         white_player = players.MiniMaxPlayer(
-            max_depth=depth, evaluation_strategy=white_eval, debug=False
+            max_depth=depth, evaluation_strategy=white_eval, debug=False, shared_table=shared_table
         )
 
-    game = othello.OthelloGame(black_player=black_player, white_player=white_player)
+    # Seeded after the players exist: RandomPlayer() reseeds from the clock.
+    if seed is not None:
+        players.seed(seed)
+
+    time_ms, increment_ms = clock if clock else (0.0, 0.0)
+    game = othello.OthelloGame(black_player=black_player, white_player=white_player,
+                               time_ms=time_ms, increment_ms=increment_ms)
+    start_time = time.perf_counter()
     result = game.play()
+    duration = time.perf_counter() - start_time
+
+    row = {
+        "black": black_eval,
+        "white": white_eval,
+        "game": game_index,
+        "depth": depth,
+        "seed": "" if seed is None else seed,
+        "clock": clock_setting(clock),
+        "winner": result,
+        "lost_on_time": game.lost_on_time or "",
+        "black_discs": bin(game.black_board).count("1"),
+        "white_discs": bin(game.white_board).count("1"),
+        "duration_s": round(duration, 6),
+        "black_nodes": sum(record["nodes"] for record in game.move_log if record["player"] == "black"),
+        "white_nodes": sum(record["nodes"] for record in game.move_log if record["player"] == "white"),
+    }
+    return row, game.black_stats, game.white_stats
 
-    return black_eval, white_eval, result
 
+def latency_rows(stats_by_player):
+    rows = []
+    for player, stats in stats_by_player.items():
+        for phase, summary in stats.summary().items():
+            if summary["moves"] == 0:
+                continue
+            latency = summary["latency_ns"]
+            rows.append({
+                "Player": player,
+                "Phase": phase,
+                "Moves": summary["moves"],
+                "p50 (ms)": latency["p50"] / 1e6,
+                "p90 (ms)": latency["p90"] / 1e6,
+                "p99 (ms)": latency["p99"] / 1e6,
+                "Max (ms)": latency["max"] / 1e6,
+                "p99 Nodes": summary["nodes"]["p99"],
+                "Mean Legal Moves": summary["legal_moves"]["mean"],
+            })
+    return rows
 
-def test_evaluations(black_evals, white_evals, depth=3, games_per_pair=10):
+
+def test_evaluations(black_evals, white_evals, writer, depth=3, games_per_pair=10, clock=None, seed=0, shared_table=None):
     tasks = [
-        (black_eval, white_eval)
+        (black_eval, white_eval, game_index)
         for black_eval in black_evals
         for white_eval in white_evals
-        for _ in range(games_per_pair)
+        for game_index in range(games_per_pair)
+    ]
+    # Each game keeps the seed of its place in the full schedule, so a resumed
+    # run plays the same games an uninterrupted one would have.
+    keys = [
+        writer.key({"black": black_eval, "white": white_eval, "game": game_index, "depth": depth,
+                    "seed": seed + index, "clock": clock_setting(clock)})
+        for index, (black_eval, white_eval, game_index) in enumerate(tasks)
     ]
-    total_games = len(tasks)
+    done = writer.completed()
+    remaining = [(index, task) for index, task in enumerate(tasks) if keys[index] not in done]
+    if len(remaining) < len(tasks):
+        print(f"Resuming: {len(tasks) - len(remaining)} of {len(tasks)} games already recorded in {writer.path}.")
 
-    results_dict = defaultdict(lambda: {"Black Wins": 0, "White Wins": 0, "Ties": 0})
+    stats_by_player = defaultdict(othello.MoveStats)
 
-    with ProcessPoolExecutor() as executor, tqdm(total=total_games, desc="Total Games Completed") as pbar:
-        futures = [executor.submit(play_single_game, black_eval, white_eval, depth) for black_eval, white_eval in tasks]
+    with ProcessPoolExecutor() as executor, tqdm(total=len(remaining), desc="Total Games Completed") as pbar:
+        futures = [
+            executor.submit(play_single_game, black_eval, white_eval, depth, clock, seed + index, game_index, shared_table)
+            for index, (black_eval, white_eval, game_index) in remaining
+        ]
 
         for future in as_completed(futures):
-            black_eval, white_eval, result = future.result()
-
-            if result == 1:
-                results_dict[(black_eval, white_eval)]["Black Wins"] += 1
-            elif result == -1:
-                results_dict[(black_eval, white_eval)]["White Wins"] += 1
-            else:
-                results_dict[(black_eval, white_eval)]["Ties"] += 1
-
+            row, black_stats, white_stats = future.result()
+            writer.write(row)
+            stats_by_player[row["black"]].merge(black_stats)
+            stats_by_player[row["white"]].merge(white_stats)
             pbar.update(1)
 
-    results = []
-    for (black_eval, white_eval), counts in results_dict.items():
-        total_games_for_pair = counts["Black Wins"] + counts["White Wins"] + counts["Ties"]
-        results.append({
-            "Black Evaluation": black_eval,
-            "White Evaluation": white_eval,
-            "Black Win Rate (%)": (counts["Black Wins"] / total_games_for_pair) * 100,
-            "White Win Rate (%)": (counts["White Wins"] / total_games_for_pair) * 100,
-            "Tie Rate (%)": (counts["Ties"] / total_games_for_pair) * 100
-        })
-
-    return results
+    writer.flush()
+    return latency_rows(stats_by_player), set(keys)
 
 
 def format_excel_sheet(sheet):
+    from openpyxl.styles import Alignment, Font
+
     for row in sheet.iter_rows():
         for cell in row:
             cell.alignment = Alignment(horizontal="center", vertical="center")
             cell.font = Font(name="Arial", size=10)
 
 
-def results_to_excel(results, black_evals, white_evals, filename="othello_results.xlsx"):
+def results_to_excel(results, black_evals, white_evals, filename="othello_results.xlsx", latency=None):
+    import pandas as pd
+
     black_win_rates = pd.DataFrame(index=black_evals, columns=white_evals, dtype=float)
     white_win_rates = pd.DataFrame(index=black_evals, columns=white_evals, dtype=float)
     tie_rates = pd.DataFrame(index=black_evals, columns=white_evals, dtype=float)
@@ -98,6 +154,10 @@ def results_to_excel(results, black_evals, white_evals, filename="othello_result
         sheet = wb["Detailed Results"]
         format_excel_sheet(sheet)
 
+        if latency:
+            pd.DataFrame(latency).to_excel(writer, sheet_name="Move Latency", index=False)
+            format_excel_sheet(wb["Move Latency"])
+
     print(f"Results saved to {filename}")
 
 def main():
@@ -124,6 +184,35 @@ def main():
         action="store_true",
         help="Whether you would like to time a game or not (default is False)."
     )
+    parser.add_argument(
+        "--results",
+        help="CSV file that games are appended to as they finish; an existing file is resumed "
+             "(default is combined_vs_all_depth_<depth>.csv)."
+    )
+    parser.add_argument(
+        "--seed",
+        type=int,
+        default=0,
+        help="Base seed; game i of the schedule is seeded with seed + i (default is 0)."
+    )
+    parser.add_argument(
+        "--excel",
+        action="store_true",
+        help="Also write the finished results to an .xlsx workbook (needs pandas and openpyxl)."
+    )
+    parser.add_argument(
+        "--shared_table",
+        type=int,
+        metavar="SIZE_MB",
+        help="Share one transposition table of SIZE_MB megabytes between all worker processes (default is none)."
+    )
+    parser.add_argument(
+        "--clock",
+        type=float,
+        nargs=2,
+        metavar=("BASE_MS", "INCREMENT_MS"),
+        help="Play tournament games on a clock; --depth then caps the iterative search (default is untimed)."
+    )
 
     args = parser.parse_args()
     
@@ -144,42 +233,80 @@ def main():
     ALL_FUNCTIONS = [
         "win_evaluate", "material_evaluate", "mobility_evaluate",
         "positional_evaluate", "corner_evaluate", "edge_evaluate",
-        "frontier_evaluate", "parity_evaluate", "combined_evaluate",
-        "random_evaluate", "random_player"
+        "frontier_evaluate", "parity_evaluate", "stability_evaluate",
+        "combined_evaluate", "random_evaluate", "random_player"
     ]
 
     if time_flag:
         print("Timing games for each evaluation function...")
-        timing_results = []
-        
-        for function in ALL_FUNCTIONS:
-            if function == "random_player":
-                black_player = players.RandomPlayer()
-            else:
-                black_player = players.MiniMaxPlayer(max_depth=depth, evaluation_strategy=function)
-
-            white_player = players.RandomPlayer()
-            
-            start_time = time.perf_counter()
-            
-            game = othello.OthelloGame(black_player=black_player, white_player=white_player)
-            game.play()
-            
-            end_time = time.perf_counter()
-            elapsed_time = end_time - start_time
-            
-            timing_results.append({"Evaluation Function": function, "Time (s)": elapsed_time})
-        
-        timing_df = pd.DataFrame(timing_results)
-        timing_df.to_excel("timing_results_" + str(depth) + ".xlsx", index=False)
-        print("Timing results saved to 'timing_results_" + str(depth) + ".xlsx'.")
+        name = f"timing_results_{depth}"
+
+        with ResultsWriter(name + ".csv", fields=TIMING_FIELDS, key_fields=("evaluation", "depth", "seed")) as writer:
+            for function in ALL_FUNCTIONS:
+                if writer.key({"evaluation": function, "depth": depth, "seed": args.seed}) in writer.completed():
+                    continue
+                if function == "random_player":
+                    black_player = players.RandomPlayer()
+                else:
+                    black_player = players.MiniMaxPlayer(max_depth=depth, evaluation_strategy=function)
+
+                white_player = players.RandomPlayer()
+                players.seed(args.seed)
+
+                start_time = time.perf_counter()
+
+                game = othello.OthelloGame(black_player=black_player, white_player=white_player)
+                game.play()
+
+                end_time = time.perf_counter()
+                elapsed_time = end_time - start_time
+
+                timing = {"evaluation": function, "depth": depth, "seed": args.seed, "time_s": round(elapsed_time, 6)}
+                for row in latency_rows({function: game.black_stats}):
+                    for suffix, column in LATENCY_COLUMNS.items():
+                        timing[f"{row['Phase']}_{suffix}"] = row[column]
+                writer.write(timing)
+        print(f"Timing results saved to '{name}.csv'.")
+
+        if args.excel:
+            import pandas as pd
+
+            timing = [row for row in read_rows(name + ".csv")
+                      if row["depth"] == str(depth) and row["seed"] == str(args.seed)]
+            latency = [
+                {"Player": row["evaluation"], "Phase": phase,
+                 **{column: (int if suffix == "moves" else float)(row[f"{phase}_{suffix}"])
+                    for suffix, column in LATENCY_COLUMNS.items()}}
+                for row in timing for phase in PHASES if row[f"{phase}_moves"]
+            ]
+            with pd.ExcelWriter(name + ".xlsx", engine='openpyxl') as writer:
+                pd.DataFrame([{"Evaluation Function": row["evaluation"], "Time (s)": float(row["time_s"])}
+                              for row in timing]).to_excel(writer, sheet_name="Game Time", index=False)
+                pd.DataFrame(latency).to_excel(writer, sheet_name="Move Latency", index=False)
+            print(f"Timing results saved to '{name}.xlsx'.")
         return
 
     black_subset = ["combined_evaluate"]
     white_subset = ALL_FUNCTIONS
-    results = test_evaluations(black_subset, white_subset, depth, games_per_pair)
     name = f"combined_vs_all_depth_{depth}"
-    results_to_excel(results, black_subset, white_subset, filename=name + ".xlsx")
+    path = args.results or name + ".csv"
+    shared_table = None
+    if args.shared_table:
+        shared_table = f"/othello-tt-{os.getpid()}"
+        players.create_shared_table(shared_table, args.shared_table)
+    try:
+        with ResultsWriter(path) as writer:
+            latency, keys = test_evaluations(black_subset, white_subset, writer, depth, games_per_pair, args.clock,
+                                             args.seed, shared_table)
+    finally:
+        if shared_table:
+            players.destroy_shared_table(shared_table)
+    print(f"Game results saved to {path}")
+
+    if args.excel:
+        # Only this configuration's games; the file may hold other runs.
+        results = summarize_games([row for row in read_rows(path) if writer.key(row) in keys])
+        results_to_excel(results, black_subset, white_subset, filename=name + ".xlsx", latency=latency)
 
 if __name__ == '__main__':
     main()
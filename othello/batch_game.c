@@ -0,0 +1,443 @@
+// othello/batch_game.c
+
+#include "batch_game.h"
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_GAME_SIMD
+#include <immintrin.h>
+#endif
+
+#define INNER_COLUMNS 0x7E7E7E7E7E7E7E7EULL
+
+static const char* KERNEL_NAMES[] = {"scalar", "avx2", "avx512"};
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t xorshift64(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static inline uint64_t pick_random_move(uint64_t moves, uint64_t* rng) {
+    int index = (int)(xorshift64(rng) % (uint64_t)popcount64(moves));
+    while (index-- > 0) {
+        moves &= moves - 1;
+    }
+    return moves & (~moves + 1);
+}
+
+// Picks a move for game i from its legal-move mask, or records a pass.
+// Returns the chosen move bit, 0 on a pass or when the game is already over.
+static inline uint64_t select_move(BatchGameObject* self, Py_ssize_t i, uint64_t moves) {
+    if (self->passes[i] >= 2) {
+        return 0;
+    }
+    if (moves == 0) {
+        self->passes[i]++;
+        if (self->passes[i] >= 2) {
+            self->active_games--;
+        }
+        return 0;
+    }
+    self->passes[i] = 0;
+    return pick_random_move(moves, &self->rng_states[i]);
+}
+
+static void step_scalar(BatchGameObject* self, Py_ssize_t start, Py_ssize_t end) {
+    for (Py_ssize_t i = start; i < end; i++) {
+        if (self->passes[i] >= 2) {
+            continue;
+        }
+
+        uint64_t player = self->player_boards[i];
+        uint64_t opponent = self->opponent_boards[i];
+        uint64_t move = select_move(self, i, get_moves_mask(player, opponent));
+
+        if (move) {
+            uint64_t flips = get_flip_mask(popcount64(move - 1), player, opponent);
+            player |= move | flips;
+            opponent &= ~flips;
+        }
+
+        if (self->passes[i] < 2) {
+            self->player_boards[i] = opponent;
+            self->opponent_boards[i] = player;
+            self->side_to_move[i] ^= 1;
+        }
+    }
+}
+
+#ifdef BATCH_GAME_SIMD
+
+// Each vector lane holds a different game; every direction is a plain lane-wise shift.
+#define AVX2_DIRECTION_MOVES(SHIFT, MASK)                                        \
+    do {                                                                         \
+        __m256i l = _mm256_and_si256(MASK, _mm256_slli_epi64(player, SHIFT));    \
+        __m256i r = _mm256_and_si256(MASK, _mm256_srli_epi64(player, SHIFT));    \
+        for (int j = 0; j < 5; j++) {                                            \
+            l = _mm256_or_si256(l, _mm256_and_si256(MASK, _mm256_slli_epi64(l, SHIFT))); \
+            r = _mm256_or_si256(r, _mm256_and_si256(MASK, _mm256_srli_epi64(r, SHIFT))); \
+        }                                                                        \
+        moves = _mm256_or_si256(moves, _mm256_slli_epi64(l, SHIFT));             \
+        moves = _mm256_or_si256(moves, _mm256_srli_epi64(r, SHIFT));             \
+    } while (0)
+
+#define AVX2_DIRECTION_FLIPS(SHIFT, MASK)                                        \
+    do {                                                                         \
+        __m256i l = _mm256_and_si256(MASK, _mm256_slli_epi64(move, SHIFT));      \
+        __m256i r = _mm256_and_si256(MASK, _mm256_srli_epi64(move, SHIFT));      \
+        for (int j = 0; j < 5; j++) {                                            \
+            l = _mm256_or_si256(l, _mm256_and_si256(MASK, _mm256_slli_epi64(l, SHIFT))); \
+            r = _mm256_or_si256(r, _mm256_and_si256(MASK, _mm256_srli_epi64(r, SHIFT))); \
+        }                                                                        \
+        __m256i l_open = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_slli_epi64(l, SHIFT), player), zero); \
+        __m256i r_open = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_srli_epi64(r, SHIFT), player), zero); \
+        flips = _mm256_or_si256(flips, _mm256_andnot_si256(l_open, l));         \
+        flips = _mm256_or_si256(flips, _mm256_andnot_si256(r_open, r));         \
+    } while (0)
+
+__attribute__((target("avx2")))
+static Py_ssize_t step_avx2(BatchGameObject* self) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i inner = _mm256_set1_epi64x((long long)INNER_COLUMNS);
+    Py_ssize_t i = 0;
+
+    for (; i + 4 <= self->num_games; i += 4) {
+        __m256i player = _mm256_loadu_si256((const __m256i*)&self->player_boards[i]);
+        __m256i opponent = _mm256_loadu_si256((const __m256i*)&self->opponent_boards[i]);
+        __m256i inner_opponent = _mm256_and_si256(opponent, inner);
+        __m256i empty = _mm256_xor_si256(_mm256_or_si256(player, opponent), _mm256_set1_epi64x(-1));
+
+        __m256i moves = zero;
+        AVX2_DIRECTION_MOVES(1, inner_opponent);
+        AVX2_DIRECTION_MOVES(8, opponent);
+        AVX2_DIRECTION_MOVES(7, inner_opponent);
+        AVX2_DIRECTION_MOVES(9, inner_opponent);
+        moves = _mm256_and_si256(moves, empty);
+
+        uint64_t lane_moves[4];
+        uint64_t lane_picks[4];
+        uint8_t was_active[4];
+        _mm256_storeu_si256((__m256i*)lane_moves, moves);
+        for (int lane = 0; lane < 4; lane++) {
+            was_active[lane] = self->passes[i + lane] < 2;
+            lane_picks[lane] = select_move(self, i + lane, lane_moves[lane]);
+        }
+
+        __m256i move = _mm256_loadu_si256((const __m256i*)lane_picks);
+        __m256i flips = zero;
+        AVX2_DIRECTION_FLIPS(1, inner_opponent);
+        AVX2_DIRECTION_FLIPS(8, opponent);
+        AVX2_DIRECTION_FLIPS(7, inner_opponent);
+        AVX2_DIRECTION_FLIPS(9, inner_opponent);
+
+        __m256i next_opponent = _mm256_or_si256(player, _mm256_or_si256(move, flips));
+        __m256i next_player = _mm256_andnot_si256(flips, opponent);
+
+        // Games that just finished or were already over keep their boards.
+        __m256i keep = _mm256_setr_epi64x(
+            -(long long)(!was_active[0] || self->passes[i] >= 2),
+            -(long long)(!was_active[1] || self->passes[i + 1] >= 2),
+            -(long long)(!was_active[2] || self->passes[i + 2] >= 2),
+            -(long long)(!was_active[3] || self->passes[i + 3] >= 2));
+        _mm256_storeu_si256((__m256i*)&self->player_boards[i], _mm256_blendv_epi8(next_player, player, keep));
+        _mm256_storeu_si256((__m256i*)&self->opponent_boards[i], _mm256_blendv_epi8(next_opponent, opponent, keep));
+
+        for (int lane = 0; lane < 4; lane++) {
+            if (was_active[lane] && self->passes[i + lane] < 2) {
+                self->side_to_move[i + lane] ^= 1;
+            }
+        }
+    }
+
+    return i;
+}
+
+#define AVX512_DIRECTION_MOVES(SHIFT, MASK)                                      \
+    do {                                                                         \
+        __m512i l = _mm512_and_si512(MASK, _mm512_slli_epi64(player, SHIFT));    \
+        __m512i r = _mm512_and_si512(MASK, _mm512_srli_epi64(player, SHIFT));    \
+        for (int j = 0; j < 5; j++) {                                            \
+            l = _mm512_or_si512(l, _mm512_and_si512(MASK, _mm512_slli_epi64(l, SHIFT))); \
+            r = _mm512_or_si512(r, _mm512_and_si512(MASK, _mm512_srli_epi64(r, SHIFT))); \
+        }                                                                        \
+        moves = _mm512_or_si512(moves, _mm512_slli_epi64(l, SHIFT));             \
+        moves = _mm512_or_si512(moves, _mm512_srli_epi64(r, SHIFT));             \
+    } while (0)
+
+#define AVX512_DIRECTION_FLIPS(SHIFT, MASK)                                      \
+    do {                                                                         \
+        __m512i l = _mm512_and_si512(MASK, _mm512_slli_epi64(move, SHIFT));      \
+        __m512i r = _mm512_and_si512(MASK, _mm512_srli_epi64(move, SHIFT));      \
+        for (int j = 0; j < 5; j++) {                                            \
+            l = _mm512_or_si512(l, _mm512_and_si512(MASK, _mm512_slli_epi64(l, SHIFT))); \
+            r = _mm512_or_si512(r, _mm512_and_si512(MASK, _mm512_srli_epi64(r, SHIFT))); \
+        }                                                                        \
+        __mmask8 l_closed = _mm512_test_epi64_mask(_mm512_slli_epi64(l, SHIFT), player); \
+        __mmask8 r_closed = _mm512_test_epi64_mask(_mm512_srli_epi64(r, SHIFT), player); \
+        flips = _mm512_mask_or_epi64(flips, l_closed, flips, l);                 \
+        flips = _mm512_mask_or_epi64(flips, r_closed, flips, r);                 \
+    } while (0)
+
+__attribute__((target("avx512f")))
+static Py_ssize_t step_avx512(BatchGameObject* self) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i inner = _mm512_set1_epi64((long long)INNER_COLUMNS);
+    Py_ssize_t i = 0;
+
+    for (; i + 8 <= self->num_games; i += 8) {
+        __m512i player = _mm512_loadu_si512(&self->player_boards[i]);
+        __m512i opponent = _mm512_loadu_si512(&self->opponent_boards[i]);
+        __m512i inner_opponent = _mm512_and_si512(opponent, inner);
+        __m512i empty = _mm512_andnot_si512(_mm512_or_si512(player, opponent), _mm512_set1_epi64(-1));
+
+        __m512i moves = zero;
+        AVX512_DIRECTION_MOVES(1, inner_opponent);
+        AVX512_DIRECTION_MOVES(8, opponent);
+        AVX512_DIRECTION_MOVES(7, inner_opponent);
+        AVX512_DIRECTION_MOVES(9, inner_opponent);
+        moves = _mm512_and_si512(moves, empty);
+
+        uint64_t lane_moves[8];
+        uint64_t lane_picks[8];
+        __mmask8 update = 0;
+        _mm512_storeu_si512(lane_moves, moves);
+        for (int lane = 0; lane < 8; lane++) {
+            bool was_active = self->passes[i + lane] < 2;
+            lane_picks[lane] = select_move(self, i + lane, lane_moves[lane]);
+            if (was_active && self->passes[i + lane] < 2) {
+                update |= (__mmask8)(1u << lane);
+                self->side_to_move[i + lane] ^= 1;
+            }
+        }
+
+        __m512i move = _mm512_loadu_si512(lane_picks);
+        __m512i flips = zero;
+        AVX512_DIRECTION_FLIPS(1, inner_opponent);
+        AVX512_DIRECTION_FLIPS(8, opponent);
+        AVX512_DIRECTION_FLIPS(7, inner_opponent);
+        AVX512_DIRECTION_FLIPS(9, inner_opponent);
+
+        __m512i next_opponent = _mm512_or_si512(player, _mm512_or_si512(move, flips));
+        __m512i next_player = _mm512_andnot_si512(flips, opponent);
+        _mm512_mask_storeu_epi64(&self->player_boards[i], update, next_player);
+        _mm512_mask_storeu_epi64(&self->opponent_boards[i], update, next_opponent);
+    }
+
+    return i;
+}
+
+#endif /* BATCH_GAME_SIMD */
+
+static BatchKernel detect_kernel(void) {
+#ifdef BATCH_GAME_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return BATCH_KERNEL_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return BATCH_KERNEL_AVX2;
+    }
+#endif
+    return BATCH_KERNEL_SCALAR;
+}
+
+static Py_ssize_t BatchGame_step_all(BatchGameObject* self) {
+    Py_ssize_t done = 0;
+#ifdef BATCH_GAME_SIMD
+    if (self->kernel == BATCH_KERNEL_AVX512) {
+        done = step_avx512(self);
+    } else if (self->kernel == BATCH_KERNEL_AVX2) {
+        done = step_avx2(self);
+    }
+#endif
+    step_scalar(self, done, self->num_games);
+    return self->active_games;
+}
+
+static void BatchGame_reset_state(BatchGameObject* self, uint64_t seed) {
+    uint64_t seed_state = seed;
+    for (Py_ssize_t i = 0; i < self->num_games; i++) {
+        self->player_boards[i] = (1ULL << 28) | (1ULL << 35);
+        self->opponent_boards[i] = (1ULL << 27) | (1ULL << 36);
+        self->side_to_move[i] = 0;
+        self->passes[i] = 0;
+        self->rng_states[i] = splitmix64(&seed_state) | 1ULL;
+    }
+    self->active_games = self->num_games;
+}
+
+static PyObject* BatchGame_step(BatchGameObject* self, PyObject* Py_UNUSED(ignored)) {
+    return PyLong_FromSsize_t(BatchGame_step_all(self));
+}
+
+static PyObject* BatchGame_play(BatchGameObject* self, PyObject* Py_UNUSED(ignored)) {
+    Py_BEGIN_ALLOW_THREADS
+    while (BatchGame_step_all(self) > 0) {
+    }
+    Py_END_ALLOW_THREADS
+
+    Py_ssize_t black_wins = 0, white_wins = 0, ties = 0;
+    for (Py_ssize_t i = 0; i < self->num_games; i++) {
+        int diff = popcount64(self->player_boards[i]) - popcount64(self->opponent_boards[i]);
+        if (self->side_to_move[i] == 1) {
+            diff = -diff;
+        }
+        if (diff > 0) {
+            black_wins++;
+        } else if (diff < 0) {
+            white_wins++;
+        } else {
+            ties++;
+        }
+    }
+
+    return Py_BuildValue("(nnn)", black_wins, white_wins, ties);
+}
+
+static PyObject* BatchGame_results(BatchGameObject* self, PyObject* Py_UNUSED(ignored)) {
+    PyObject* results = PyList_New(self->num_games);
+    if (results == NULL) {
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < self->num_games; i++) {
+        int winner = 0;
+        if (self->passes[i] >= 2) {
+            int diff = popcount64(self->player_boards[i]) - popcount64(self->opponent_boards[i]);
+            if (self->side_to_move[i] == 1) {
+                diff = -diff;
+            }
+            winner = (diff > 0) - (diff < 0);
+        }
+        PyList_SET_ITEM(results, i, PyLong_FromLong(winner));
+    }
+
+    return results;
+}
+
+static PyObject* BatchGame_reset(BatchGameObject* self, PyObject* args) {
+    unsigned long long seed = 0;
+    if (!PyArg_ParseTuple(args, "|K", &seed)) {
+        return NULL;
+    }
+    BatchGame_reset_state(self, seed);
+    Py_RETURN_NONE;
+}
+
+static PyObject* BatchGame_get_kernel(BatchGameObject* self, void* closure) {
+    return PyUnicode_FromString(KERNEL_NAMES[self->kernel]);
+}
+
+static PyObject* BatchGame_get_active(BatchGameObject* self, void* closure) {
+    return PyLong_FromSsize_t(self->active_games);
+}
+
+static void BatchGame_free_arrays(BatchGameObject* self) {
+    PyMem_Free(self->player_boards);
+    PyMem_Free(self->opponent_boards);
+    PyMem_Free(self->rng_states);
+    PyMem_Free(self->side_to_move);
+    PyMem_Free(self->passes);
+    self->player_boards = NULL;
+    self->opponent_boards = NULL;
+    self->rng_states = NULL;
+    self->side_to_move = NULL;
+    self->passes = NULL;
+}
+
+static int BatchGame_init(BatchGameObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"num_games", "seed", "kernel", NULL};
+
+    Py_ssize_t num_games;
+    unsigned long long seed = 0;
+    const char* kernel = "auto";
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|Ks", kwlist, &num_games, &seed, &kernel)) {
+        return -1;
+    }
+
+    if (num_games <= 0) {
+        PyErr_SetString(PyExc_ValueError, "num_games must be positive.");
+        return -1;
+    }
+
+    BatchKernel available = detect_kernel();
+    if (strcmp(kernel, "auto") == 0) {
+        self->kernel = available;
+    } else {
+        int found = -1;
+        for (int i = 0; i <= (int)BATCH_KERNEL_AVX512; i++) {
+            if (strcmp(kernel, KERNEL_NAMES[i]) == 0) {
+                found = i;
+            }
+        }
+        if (found < 0 || found > (int)available) {
+            PyErr_Format(PyExc_ValueError, "Kernel '%s' is not available on this machine.", kernel);
+            return -1;
+        }
+        self->kernel = (BatchKernel)found;
+    }
+
+    BatchGame_free_arrays(self);
+    self->num_games = num_games;
+    self->player_boards = PyMem_Malloc(sizeof(uint64_t) * num_games);
+    self->opponent_boards = PyMem_Malloc(sizeof(uint64_t) * num_games);
+    self->rng_states = PyMem_Malloc(sizeof(uint64_t) * num_games);
+    self->side_to_move = PyMem_Malloc(num_games);
+    self->passes = PyMem_Malloc(num_games);
+    if (!self->player_boards || !self->opponent_boards || !self->rng_states || !self->side_to_move || !self->passes) {
+        BatchGame_free_arrays(self);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    BatchGame_reset_state(self, seed);
+    return 0;
+}
+
+static void BatchGame_dealloc(BatchGameObject* self) {
+    BatchGame_free_arrays(self);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyMethodDef BatchGame_methods[] = {
+    {"step", (PyCFunction)BatchGame_step, METH_NOARGS,
+     "Plays one random ply in every unfinished game and returns the number still running."},
+    {"play", (PyCFunction)BatchGame_play, METH_NOARGS,
+     "Plays every game to completion and returns (black_wins, white_wins, ties)."},
+    {"results", (PyCFunction)BatchGame_results, METH_NOARGS,
+     "Returns the winner of each game (1 black, -1 white, 0 tie or unfinished)."},
+    {"reset", (PyCFunction)BatchGame_reset, METH_VARARGS,
+     "Resets every game to the starting position with the given seed."},
+    {NULL}
+};
+
+static PyGetSetDef BatchGame_getset[] = {
+    {"kernel", (getter)BatchGame_get_kernel, NULL, "Name of the step kernel in use.", NULL},
+    {"active_games", (getter)BatchGame_get_active, NULL, "Number of games not yet finished.", NULL},
+    {NULL}
+};
+
+PyTypeObject BatchGameType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "othello.BatchGame",
+    .tp_basicsize = sizeof(BatchGameObject),
+    .tp_dealloc = (destructor)BatchGame_dealloc,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Many random-playout games stepped in lockstep",
+    .tp_methods = BatchGame_methods,
+    .tp_getset = BatchGame_getset,
+    .tp_init = (initproc)BatchGame_init,
+    .tp_new = PyType_GenericNew,
+};
@@ -0,0 +1,31 @@
+// othello/batch_game.h
+
+#ifndef BATCH_GAME_H
+#define BATCH_GAME_H
+
+#include "othello.h"
+
+typedef enum {
+    BATCH_KERNEL_SCALAR,
+    BATCH_KERNEL_AVX2,
+    BATCH_KERNEL_AVX512
+} BatchKernel;
+
+// N independent games in structure-of-arrays form. Boards are stored from the
+// point of view of the side to move; side_to_move is 0 for black and 1 for white.
+// passes counts consecutive passes, a game is finished once it reaches 2.
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t num_games;
+    uint64_t* player_boards;
+    uint64_t* opponent_boards;
+    uint64_t* rng_states;
+    uint8_t* side_to_move;
+    uint8_t* passes;
+    Py_ssize_t active_games;
+    BatchKernel kernel;
+} BatchGameObject;
+
+extern PyTypeObject BatchGameType;
+
+#endif /* BATCH_GAME_H */
@@ -0,0 +1,211 @@
+// othello/move_stats.c
+
+#include "move_stats.h"
+#include "board.h"
+#include <string.h>
+
+static const char* PHASE_NAMES[MOVE_PHASE_COUNT] = {"opening", "midgame", "endgame"};
+static const char* METRIC_NAMES[MOVE_METRIC_COUNT] = {"latency_ns", "nodes", "legal_moves"};
+
+static int highest_bit(uint64_t value) {
+    value |= value >> 1;
+    value |= value >> 2;
+    value |= value >> 4;
+    value |= value >> 8;
+    value |= value >> 16;
+    value |= value >> 32;
+    return popcount64(value) - 1;
+}
+
+static int histogram_bucket(uint64_t value) {
+    if (value < HISTOGRAM_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int shift = highest_bit(value) - HISTOGRAM_SUB_BITS;
+    return (shift + 1) * HISTOGRAM_SUB_BUCKETS + (int)((value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+static uint64_t histogram_bucket_top(int bucket) {
+    if (bucket < HISTOGRAM_SUB_BUCKETS) {
+        return (uint64_t)bucket;
+    }
+    int shift = bucket / HISTOGRAM_SUB_BUCKETS - 1;
+    uint64_t low = (uint64_t)(HISTOGRAM_SUB_BUCKETS + bucket % HISTOGRAM_SUB_BUCKETS) << shift;
+    return low + ((1ULL << shift) - 1);
+}
+
+static void histogram_add(Histogram* histogram, uint64_t value) {
+    histogram->count++;
+    histogram->sum += value;
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+    histogram->buckets[histogram_bucket(value)]++;
+}
+
+static void histogram_merge(Histogram* into, const Histogram* from) {
+    into->count += from->count;
+    into->sum += from->sum;
+    if (from->max > into->max) {
+        into->max = from->max;
+    }
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        into->buckets[i] += from->buckets[i];
+    }
+}
+
+// Upper edge of the bucket holding the given quantile, never above the maximum seen.
+static uint64_t histogram_quantile(const Histogram* histogram, double quantile) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(quantile * histogram->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            uint64_t top = histogram_bucket_top(i);
+            return top < histogram->max ? top : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+MoveStatsObject* move_stats_new(void) {
+    return (MoveStatsObject*)PyObject_CallNoArgs((PyObject*)&MoveStatsType);
+}
+
+void move_stats_record(MoveStatsObject* stats, int discs, uint64_t latency_ns, uint64_t nodes, uint64_t legal_moves) {
+    MovePhase phase = discs <= 15 ? MOVE_PHASE_OPENING : (discs <= 45 ? MOVE_PHASE_MIDGAME : MOVE_PHASE_ENDGAME);
+    Histogram* histograms = stats->histograms[phase];
+    histogram_add(&histograms[MOVE_METRIC_LATENCY_NS], latency_ns);
+    histogram_add(&histograms[MOVE_METRIC_NODES], nodes);
+    histogram_add(&histograms[MOVE_METRIC_LEGAL_MOVES], legal_moves);
+}
+
+static PyObject* histogram_summary(const Histogram* histogram) {
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:d}",
+                         "p50", (unsigned long long)histogram_quantile(histogram, 0.50),
+                         "p90", (unsigned long long)histogram_quantile(histogram, 0.90),
+                         "p99", (unsigned long long)histogram_quantile(histogram, 0.99),
+                         "max", (unsigned long long)histogram->max,
+                         "mean", histogram->count ? (double)histogram->sum / histogram->count : 0.0);
+}
+
+static PyObject* MoveStats_summary(MoveStatsObject* self, PyObject* Py_UNUSED(ignored)) {
+    PyObject* result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+
+    for (int phase = 0; phase < MOVE_PHASE_COUNT; phase++) {
+        PyObject* phase_dict = Py_BuildValue("{s:K}", "moves", (unsigned long long)self->histograms[phase][0].count);
+        if (phase_dict == NULL) {
+            Py_DECREF(result);
+            return NULL;
+        }
+
+        for (int metric = 0; metric < MOVE_METRIC_COUNT; metric++) {
+            PyObject* summary = histogram_summary(&self->histograms[phase][metric]);
+            if (summary == NULL || PyDict_SetItemString(phase_dict, METRIC_NAMES[metric], summary) < 0) {
+                Py_XDECREF(summary);
+                Py_DECREF(phase_dict);
+                Py_DECREF(result);
+                return NULL;
+            }
+            Py_DECREF(summary);
+        }
+
+        int status = PyDict_SetItemString(result, PHASE_NAMES[phase], phase_dict);
+        Py_DECREF(phase_dict);
+        if (status < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+    }
+
+    return result;
+}
+
+static PyObject* MoveStats_merge(MoveStatsObject* self, PyObject* other) {
+    if (!PyObject_TypeCheck(other, &MoveStatsType)) {
+        PyErr_SetString(PyExc_TypeError, "merge() argument must be a MoveStats.");
+        return NULL;
+    }
+
+    MoveStatsObject* from = (MoveStatsObject*)other;
+    for (int phase = 0; phase < MOVE_PHASE_COUNT; phase++) {
+        for (int metric = 0; metric < MOVE_METRIC_COUNT; metric++) {
+            histogram_merge(&self->histograms[phase][metric], &from->histograms[phase][metric]);
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* MoveStats_reset(MoveStatsObject* self, PyObject* Py_UNUSED(ignored)) {
+    memset(self->histograms, 0, sizeof(self->histograms));
+    Py_RETURN_NONE;
+}
+
+// Pickled as the raw histograms so results can travel back from worker processes.
+static PyObject* MoveStats_reduce(MoveStatsObject* self, PyObject* Py_UNUSED(ignored)) {
+    PyObject* state = PyBytes_FromStringAndSize((const char*)self->histograms, (Py_ssize_t)sizeof(self->histograms));
+    if (state == NULL) {
+        return NULL;
+    }
+    return Py_BuildValue("(O()N)", (PyObject*)Py_TYPE(self), state);
+}
+
+static PyObject* MoveStats_setstate(MoveStatsObject* self, PyObject* state) {
+    char* data;
+    Py_ssize_t size;
+    if (PyBytes_AsStringAndSize(state, &data, &size) < 0) {
+        return NULL;
+    }
+    if (size != (Py_ssize_t)sizeof(self->histograms)) {
+        PyErr_SetString(PyExc_ValueError, "MoveStats state has the wrong size.");
+        return NULL;
+    }
+    memcpy(self->histograms, data, sizeof(self->histograms));
+    Py_RETURN_NONE;
+}
+
+static PyObject* MoveStats_get_moves(MoveStatsObject* self, void* closure) {
+    unsigned long long moves = 0;
+    for (int phase = 0; phase < MOVE_PHASE_COUNT; phase++) {
+        moves += self->histograms[phase][0].count;
+    }
+    return PyLong_FromUnsignedLongLong(moves);
+}
+
+static PyMethodDef MoveStats_methods[] = {
+    {"summary", (PyCFunction)MoveStats_summary, METH_NOARGS,
+     "Returns {phase: {'moves': n, metric: {'p50', 'p90', 'p99', 'max', 'mean'}}} for latency_ns, nodes and legal_moves."},
+    {"merge", (PyCFunction)MoveStats_merge, METH_O,
+     "Adds another MoveStats' samples to this one."},
+    {"reset", (PyCFunction)MoveStats_reset, METH_NOARGS,
+     "Discards all samples."},
+    {"__reduce__", (PyCFunction)MoveStats_reduce, METH_NOARGS, NULL},
+    {"__setstate__", (PyCFunction)MoveStats_setstate, METH_O, NULL},
+    {NULL}
+};
+
+static PyGetSetDef MoveStats_getset[] = {
+    {"moves", (getter)MoveStats_get_moves, NULL, "Number of recorded decisions.", NULL},
+    {NULL}
+};
+
+PyTypeObject MoveStatsType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "othello.MoveStats",
+    .tp_basicsize = sizeof(MoveStatsObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Per-phase histograms of move latency, nodes searched and legal-move counts",
+    .tp_methods = MoveStats_methods,
+    .tp_getset = MoveStats_getset,
+    .tp_new = PyType_GenericNew,
+};
@@ -0,0 +1,49 @@
+// othello/move_stats.h
+
+#ifndef MOVE_STATS_H
+#define MOVE_STATS_H
+
+#include <Python.h>
+#include <stdint.h>
+
+// Log-linear histogram: values below 16 get exact buckets, larger ones 16
+// buckets per power of two, so any percentile is within 1/16 of the truth.
+#define HISTOGRAM_SUB_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS ((64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+} Histogram;
+
+// Phases follow combined_evaluate: up to 15 discs, up to 45, then the rest.
+typedef enum {
+    MOVE_PHASE_OPENING,
+    MOVE_PHASE_MIDGAME,
+    MOVE_PHASE_ENDGAME,
+    MOVE_PHASE_COUNT
+} MovePhase;
+
+typedef enum {
+    MOVE_METRIC_LATENCY_NS,
+    MOVE_METRIC_NODES,
+    MOVE_METRIC_LEGAL_MOVES,
+    MOVE_METRIC_COUNT
+} MoveMetric;
+
+typedef struct {
+    PyObject_HEAD
+    Histogram histograms[MOVE_PHASE_COUNT][MOVE_METRIC_COUNT];
+} MoveStatsObject;
+
+extern PyTypeObject MoveStatsType;
+
+MoveStatsObject* move_stats_new(void);
+
+// Records one decision taken with discs on the board before the move.
+void move_stats_record(MoveStatsObject* stats, int discs, uint64_t latency_ns, uint64_t nodes, uint64_t legal_moves);
+
+#endif /* MOVE_STATS_H */
@@ -1,45 +1,10 @@
 // othello/othello.c
 
-#define OTHELLO_EXPORTS
-
 #include "othello.h"
+#include "batch_game.h"
+#include "timer.h"
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
-
-#if defined(_MSC_VER)
-#include <intrin.h>
-
-OTHELLO_API int popcount64(uint64_t x) {
-    return (int)__popcnt64(x);
-}
-
-#elif defined(__GNUC__) || defined(__clang__)
-OTHELLO_API int popcount64(uint64_t x) {
-    return __builtin_popcountll(x);
-}
-#else
-OTHELLO_API int popcount64(uint64_t x) {
-    x = x - ((x >> 1) & 0x5555555555555555ULL);
-    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
-    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
-    x = x + (x >> 8);
-    x = x + (x >> 16);
-    x = x + (x >> 32);
-    return (int)(x & 0x7F);
-}
-#endif
-
-const Direction DIRECTIONS[8] = {
-    {-1, 0},  // Up
-    {1, 0},   // Down
-    {0, -1},  // Left
-    {0, 1},   // Right
-    {-1, -1}, // Up-Left
-    {-1, 1},  // Up-Right
-    {1, -1},  // Down-Left
-    {1, 1}    // Down-Right
-};
 
 static void OthelloGame_initialize_boards(OthelloGameObject* self);
 static uint64_t set_piece(int row, int col, uint64_t board);
@@ -53,153 +18,73 @@ static uint64_t set_piece(int row, int col, uint64_t board) {
     return board;
 }
 
+static void game_state_update_moves(GameState* state) {
+    uint64_t player_board = state->black_to_move ? state->black_board : state->white_board;
+    uint64_t opponent_board = state->black_to_move ? state->white_board : state->black_board;
+    state->moves = get_moves_mask(player_board, opponent_board);
+    state->opponent_moves = get_moves_mask(opponent_board, player_board);
+}
+
 static void OthelloGame_initialize_boards(OthelloGameObject* self) {
-    self->black_board = 0ULL;
-    self->white_board = 0ULL;
-    self->black_board = set_piece(3, 4, self->black_board);
-    self->black_board = set_piece(4, 3, self->black_board);
-    self->white_board = set_piece(3, 3, self->white_board);
-    self->white_board = set_piece(4, 4, self->white_board);
+    GameState* state = &self->state;
+    state->black_board = 0ULL;
+    state->white_board = 0ULL;
+    state->black_board = set_piece(3, 4, state->black_board);
+    state->black_board = set_piece(4, 3, state->black_board);
+    state->white_board = set_piece(3, 3, state->white_board);
+    state->white_board = set_piece(4, 4, state->white_board);
+    state->black_to_move = true;
+    game_state_update_moves(state);
+    self->ply = 0;
 }
 
-OTHELLO_API bool is_valid_move(int move, uint64_t player_board, uint64_t opponent_board) {
-    uint64_t all_occupied = player_board | opponent_board;
-    if ((all_occupied >> move) & 1ULL) {
-        return false;
-    }
-
-    int move_row = move / BOARD_SIZE;
-    int move_col = move % BOARD_SIZE;
-    for (int i = 0; i < 8; i++) {
-        int dr = DIRECTIONS[i].dr;
-        int dc = DIRECTIONS[i].dc;
-        int r = move_row + dr;
-        int c = move_col + dc;
-        bool bits_to_flip = false;
-        while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-            int bit = (r << 3) + c;
-            if ((opponent_board >> bit) & 1ULL) {
-                bits_to_flip = true;
-            } else if ((player_board >> bit) & 1ULL) {
-                if (bits_to_flip) {
-                    return true;
-                }
-                break;
-            } else {
-                break;
-            }
-            r += dr;
-            c += dc;
-        }
-    }
-    return false;
+static PyObject* OthelloGame_current_player(OthelloGameObject* self) {
+    return self->state.black_to_move ? self->black_player : self->white_player;
 }
 
-OTHELLO_API void get_valid_moves(uint64_t player_board, uint64_t opponent_board, MoveList* move_list) {
-    uint64_t all_occupied = player_board | opponent_board;
-    bool potential_moves[64] = {false};
-    for (int bit = 0; bit < 64; bit++) {
-        if ((opponent_board >> bit) & 1ULL) {
-            int row = bit / BOARD_SIZE;
-            int col = bit % BOARD_SIZE;
-            for (int i = 0; i < 8; i++) {
-                int dr = DIRECTIONS[i].dr;
-                int dc = DIRECTIONS[i].dc;
-                int r = row + dr;
-                int c = col + dc;
-                if (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-                    int candidate_bit = (r << 3) + c;
-                    if (!((all_occupied >> candidate_bit) & 1ULL)) {
-                        potential_moves[candidate_bit] = true;
-                    }
-                }
-            }
-        }
-    }
-    move_list->count = 0;
-    for (int move = 0; move < 64; move++) {
-        if (potential_moves[move]) {
-            if (is_valid_move(move, player_board, opponent_board)) {
-                move_list->moves[move_list->count++] = move;
-            }
-        }
-    }
+bool is_game_over(OthelloGameObject* self) {
+    return (self->state.moves | self->state.opponent_moves) == 0;
 }
 
-OTHELLO_API void get_flipped_bits(int move, uint64_t player_board, uint64_t opponent_board, BitList* bit_list) {
-    int move_row = move / BOARD_SIZE;
-    int move_col = move % BOARD_SIZE;
-    bit_list->count = 0;
-
-    for (int i = 0; i < 8; i++) {
-        int dr = DIRECTIONS[i].dr;
-        int dc = DIRECTIONS[i].dc;
-        int r = move_row + dr;
-        int c = move_col + dc;
-        int temp_flip[64];
-        int temp_count = 0;
-        while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-            int bit = (r << 3) + c;
-            if ((opponent_board >> bit) & 1ULL) {
-                temp_flip[temp_count++] = bit;
-            } else if ((player_board >> bit) & 1ULL) {
-                if (temp_count > 0) {
-                    memcpy(&bit_list->bits[bit_list->count], temp_flip, temp_count * sizeof(int));
-                    bit_list->count += temp_count;
-                }
-                break;
-            } else {
-                break;
-            }
-            r += dr;
-            c += dc;
-        }
+// Plays move without checking it. A pass only swaps the sides and their masks.
+static void OthelloGame_push_state(OthelloGameObject* self, int move) {
+    GameState* state = &self->state;
+    HistoryEntry* entry = &self->history[self->ply++];
+    entry->state = *state;
+    entry->move = move;
+
+    if (move < 0) {
+        uint64_t moves = state->moves;
+        state->moves = state->opponent_moves;
+        state->opponent_moves = moves;
+        state->black_to_move = !state->black_to_move;
+        return;
     }
-}
 
-OTHELLO_API bool is_game_over(OthelloGameObject* self) {
-    MoveList black_moves;
-    MoveList white_moves;
-    get_valid_moves(self->black_board, self->white_board, &black_moves);
-    get_valid_moves(self->white_board, self->black_board, &white_moves);
-    return (black_moves.count == 0) && (white_moves.count == 0);
+    uint64_t* player_board = state->black_to_move ? &state->black_board : &state->white_board;
+    uint64_t* opponent_board = state->black_to_move ? &state->white_board : &state->black_board;
+    uint64_t flips = get_flip_mask(move, *player_board, *opponent_board);
+    *player_board |= flips | (1ULL << move);
+    *opponent_board &= ~flips;
+    state->black_to_move = !state->black_to_move;
+    game_state_update_moves(state);
 }
 
-OTHELLO_API int OthelloGame_apply_move(OthelloGameObject* self, int move) {
-    uint64_t player_board, opponent_board;
-    if (self->current_player == self->black_player) {
-        player_board = self->black_board;
-        opponent_board = self->white_board;
-    } else {
-        player_board = self->white_board;
-        opponent_board = self->black_board;
+int OthelloGame_apply_move(OthelloGameObject* self, int move) {
+    const GameState* state = &self->state;
+    if (self->ply == MAX_GAME_PLIES) {
+        return 0;
     }
-
-    BitList bits_to_flip;
-    get_flipped_bits(move, player_board, opponent_board, &bits_to_flip);
-
-    if (bits_to_flip.count > 0) {
-        player_board |= 1ULL << move;
-        for (int i = 0; i < bits_to_flip.count; i++) {
-            int bit = bits_to_flip.bits[i];
-            player_board |= 1ULL << bit;
-            opponent_board &= ~(1ULL << bit);
+    if (move < 0) {
+        if (state->moves != 0 || state->opponent_moves == 0) {
+            return 0;
         }
-
-        if (self->current_player == self->black_player) {
-            self->black_board = player_board;
-            self->white_board = opponent_board;
-        } else {
-            self->white_board = player_board;
-            self->black_board = opponent_board;
-        }
-
-        self->current_player = (self->current_player == self->black_player) ? self->white_player : self->black_player;
-
-        return 1;
-    } else {
+    } else if (move >= 64 || !((state->moves >> move) & 1)) {
         return 0;
     }
+
+    OthelloGame_push_state(self, move);
+    return 1;
 }
 
 static PyObject* OthelloGame_display_board(OthelloGameObject* self) {
@@ -228,9 +113,9 @@ static PyObject* OthelloGame_display_board(OthelloGameObject* self) {
         for (int col = 0; col < BOARD_SIZE; col++) {
             int bit = (row << 3) + col;
             const char* cell;
-            if ((self->black_board >> bit) & 1ULL) {
+            if ((self->state.black_board >> bit) & 1ULL) {
                 cell = BLACK_CELL;
-            } else if ((self->white_board >> bit) & 1ULL) {
+            } else if ((self->state.white_board >> bit) & 1ULL) {
                 cell = WHITE_CELL;
             } else {
                 cell = EMPTY_CELL;
@@ -252,74 +137,119 @@ static PyObject* OthelloGame_display_board(OthelloGameObject* self) {
 }
 
 
-static PyObject* OthelloGame_make_move(OthelloGameObject* self) {
-    uint64_t player_board, opponent_board;
-    if (self->current_player == self->black_player) {
-        player_board = self->black_board;
-        opponent_board = self->white_board;
-    } else {
-        player_board = self->white_board;
-        opponent_board = self->black_board;
-    }
-
-    MoveList valid_moves;
-    get_valid_moves(player_board, opponent_board, &valid_moves);
+// Players that search expose the node count of their last decision as "nodes".
+static void OthelloGame_record_move(OthelloGameObject* self, int move, int legal_moves, uint64_t latency_ns, uint64_t occupied) {
+    bool black = self->state.black_to_move;
+    uint64_t nodes = 0;
 
-    if (valid_moves.count == 0) {
-        self->current_player = (self->current_player == self->black_player) ? self->white_player : self->black_player;
-        if (self->current_player == self->black_player) {
-            player_board = self->black_board;
-            opponent_board = self->white_board;
-        } else {
-            player_board = self->white_board;
-            opponent_board = self->black_board;
+    if (black ? self->black_reports_nodes : self->white_reports_nodes) {
+        PyObject* nodes_obj = PyObject_GetAttrString(OthelloGame_current_player(self), "nodes");
+        if (nodes_obj != NULL) {
+            nodes = PyLong_AsUnsignedLongLong(nodes_obj);
+            Py_DECREF(nodes_obj);
         }
-        get_valid_moves(player_board, opponent_board, &valid_moves);
-        if (valid_moves.count == 0) {
-            Py_RETURN_FALSE;
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            nodes = 0;
         }
     }
 
-    PyObject* move_obj = PyObject_CallMethod(self->current_player, "decide_move", "KKK",
-                                             (unsigned long long)valid_moves.count,
-                                             (unsigned long long)player_board,
-                                             (unsigned long long)opponent_board);
-    if (!move_obj) {
-        return NULL;
+    move_stats_record(black ? self->black_stats : self->white_stats, popcount64(occupied), latency_ns, nodes,
+                      (uint64_t)legal_moves);
+
+    if (self->move_count < MAX_MOVE_RECORDS) {
+        MoveRecord* record = &self->move_log[self->move_count++];
+        record->move = move;
+        record->black = black;
+        record->legal_moves = legal_moves;
+        record->latency_ns = latency_ns;
+        record->nodes = nodes;
     }
+}
 
-    if (move_obj == Py_None) {
-        Py_DECREF(move_obj);
-        self->current_player = (self->current_player == self->black_player) ? self->white_player : self->black_player;
-        Py_RETURN_TRUE;
+static PyObject* OthelloGame_make_move(OthelloGameObject* self) {
+    if (is_game_over(self)) {
+        Py_RETURN_FALSE;
+    }
+    if (self->state.moves == 0) {
+        OthelloGame_push_state(self, -1);
     }
 
-    int move = (int)PyLong_AsLong(move_obj);
+    const GameState* state = &self->state;
+    uint64_t player_board = state->black_to_move ? state->black_board : state->white_board;
+    uint64_t opponent_board = state->black_to_move ? state->white_board : state->black_board;
+    int legal_moves = popcount64(state->moves);
+
+    int side = state->black_to_move ? 0 : 1;
+    uint64_t start = monotonic_ns();
+    PyObject* move_obj;
+    if (self->timed) {
+        move_obj = PyObject_CallMethod(OthelloGame_current_player(self), "decide_move", "KKKdd",
+                                       (unsigned long long)legal_moves,
+                                       (unsigned long long)player_board,
+                                       (unsigned long long)opponent_board,
+                                       self->time_left_ns[side] / 1e6,
+                                       self->increment_ns / 1e6);
+    } else {
+        move_obj = PyObject_CallMethod(OthelloGame_current_player(self), "decide_move", "KKK",
+                                       (unsigned long long)legal_moves,
+                                       (unsigned long long)player_board,
+                                       (unsigned long long)opponent_board);
+    }
+    uint64_t latency_ns = monotonic_ns() - start;
+    if (!move_obj) {
+        return NULL;
+    }
+
+    int move = move_obj == Py_None ? -1 : (int)PyLong_AsLong(move_obj);
     Py_DECREF(move_obj);
+    if (move == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    OthelloGame_record_move(self, move, legal_moves, latency_ns, player_board | opponent_board);
 
-    bool is_valid = false;
-    for (int i = 0; i < valid_moves.count; i++) {
-        if (valid_moves.moves[i] == move) {
-            is_valid = true;
-            break;
+    if (self->timed) {
+        self->time_left_ns[side] -= (int64_t)latency_ns;
+        if (self->time_left_ns[side] < 0) {
+            self->time_left_ns[side] = 0;
+            self->time_forfeit = side == 0 ? -1 : 1;
+            Py_RETURN_FALSE;
         }
+        self->time_left_ns[side] += (int64_t)self->increment_ns;
     }
-    if (!is_valid) {
-        PyErr_SetString(PyExc_ValueError, "Invalid move selected.");
+
+    if (self->ply == MAX_GAME_PLIES) {
+        PyErr_SetString(PyExc_RuntimeError, "Game history is full.");
         return NULL;
     }
 
-    int apply_result = OthelloGame_apply_move(self, move);
-    if (!apply_result) {
-        PyErr_SetString(PyExc_ValueError, "Failed to apply the move.");
+    // A player that returns None gives up its turn.
+    if (move < 0) {
+        OthelloGame_push_state(self, -1);
+        Py_RETURN_TRUE;
+    }
+
+    if (move >= 64 || !((state->moves >> move) & 1)) {
+        PyErr_SetString(PyExc_ValueError, "Invalid move selected.");
         return NULL;
     }
 
+    OthelloGame_push_state(self, move);
     Py_RETURN_TRUE;
 }
 
+// 1 if black has more discs or white lost on time, -1 the other way round, 0 for a tie.
+static int OthelloGame_winner(OthelloGameObject* self) {
+    if (self->time_forfeit) {
+        return self->time_forfeit;
+    }
+    int black_count = popcount64(self->state.black_board);
+    int white_count = popcount64(self->state.white_board);
+    return (black_count > white_count) - (black_count < white_count);
+}
+
 static PyObject* OthelloGame_play(OthelloGameObject* self, PyObject* Py_UNUSED(ignored)) {
-    while (!is_game_over(self)) {
+    while (!is_game_over(self) && !self->time_forfeit) {
         if (self->debug) {
             OthelloGame_display_board(self);
         }
@@ -333,51 +263,117 @@ static PyObject* OthelloGame_play(OthelloGameObject* self, PyObject* Py_UNUSED(i
 
     if (self->debug) {
         OthelloGame_display_board(self);
-        printf("Game over!\n");
+        printf(self->time_forfeit ? "Game over on time!\n" : "Game over!\n");
     }
 
-    int black_count = popcount64(self->black_board);
-    int white_count = popcount64(self->white_board);
-    int winner = 0;
+    int winner = OthelloGame_winner(self);
+    if (self->debug) {
+        printf(winner > 0 ? "Black wins!\n" : (winner < 0 ? "White wins!\n" : "It's a tie!\n"));
+    }
 
-    if (black_count > white_count) {
-        if (self->debug) {
-            printf("Black wins!\n");
-        }
-        winner = 1;
-    } else if (white_count > black_count) {
-        if (self->debug) {
-            printf("White wins!\n");
+    return PyLong_FromLong(winner);
+}
+
+static PyObject* OthelloGame_legal_moves(OthelloGameObject* self, PyObject* Py_UNUSED(ignored)) {
+    uint64_t moves = self->state.moves;
+    PyObject* result = PyList_New(popcount64(moves));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; moves; i++) {
+        int move = popcount64((moves & (~moves + 1)) - 1);
+        moves &= moves - 1;
+        PyObject* item = PyLong_FromLong(move);
+        if (item == NULL) {
+            Py_DECREF(result);
+            return NULL;
         }
-        winner = -1;
-    } else {
-        if (self->debug) {
-            printf("It's a tie!\n");
+        PyList_SET_ITEM(result, i, item);
+    }
+
+    return result;
+}
+
+static PyObject* OthelloGame_push(OthelloGameObject* self, PyObject* move_obj) {
+    int move = -1;
+    if (move_obj != Py_None) {
+        long value = PyLong_AsLong(move_obj);
+        if (value == -1 && PyErr_Occurred()) {
+            return NULL;
         }
-        winner = 0;
+        move = value < 0 || value >= 64 ? 64 : (int)value;
     }
 
-    return PyLong_FromLong(winner);
+    if (!OthelloGame_apply_move(self, move)) {
+        PyErr_SetString(PyExc_ValueError, move < 0 ? "Passing is only legal when the side to move has no moves."
+                                                   : "Illegal move.");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* OthelloGame_pop(OthelloGameObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (self->ply == 0) {
+        PyErr_SetString(PyExc_IndexError, "pop from an empty game history.");
+        return NULL;
+    }
+
+    const HistoryEntry* entry = &self->history[--self->ply];
+    self->state = entry->state;
+    if (entry->move < 0) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromLong(entry->move);
+}
+
+static PyObject* OthelloGame_result(OthelloGameObject* self, PyObject* Py_UNUSED(ignored)) {
+    if (!is_game_over(self) && !self->time_forfeit) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromLong(OthelloGame_winner(self));
 }
 
 static int OthelloGame_init(OthelloGameObject* self, PyObject* args, PyObject* kwds) {
-    PyObject* black_player = NULL;
-    PyObject* white_player = NULL;
+    PyObject* black_player = Py_None;
+    PyObject* white_player = Py_None;
     int debug = 0;
+    double time_ms = 0.0;
+    double increment_ms = 0.0;
 
-    static char* kwlist[] = {"black_player", "white_player", "debug", NULL};
+    static char* kwlist[] = {"black_player", "white_player", "debug", "time_ms", "increment_ms", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|p", kwlist,
-                                     &black_player, &white_player, &debug)) {
+    // Players are only needed by play(); push() and pop() work without them.
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOpdd", kwlist,
+                                     &black_player, &white_player, &debug, &time_ms, &increment_ms)) {
+        return -1;
+    }
+    if (time_ms < 0.0 || increment_ms < 0.0) {
+        PyErr_SetString(PyExc_ValueError, "time_ms and increment_ms must not be negative.");
         return -1;
     }
 
     Py_INCREF(black_player);
     Py_INCREF(white_player);
-    self->black_player = black_player;
-    self->white_player = white_player;
-    self->current_player = black_player;
+    Py_XSETREF(self->black_player, black_player);
+    Py_XSETREF(self->white_player, white_player);
     self->debug = debug;
+    self->timed = time_ms > 0.0;
+    self->time_left_ns[0] = self->time_left_ns[1] = (int64_t)(time_ms * 1e6);
+    self->increment_ns = (uint64_t)(increment_ms * 1e6);
+    self->time_forfeit = 0;
+
+    Py_XDECREF(self->black_stats);
+    Py_XDECREF(self->white_stats);
+    self->black_stats = move_stats_new();
+    self->white_stats = move_stats_new();
+    if (self->black_stats == NULL || self->white_stats == NULL) {
+        return -1;
+    }
+    self->move_count = 0;
+    // Looked up once: a missing attribute raises, which is too slow to repeat every move.
+    self->black_reports_nodes = PyObject_HasAttrString(black_player, "nodes");
+    self->white_reports_nodes = PyObject_HasAttrString(white_player, "nodes");
 
     OthelloGame_initialize_boards(self);
 
@@ -387,12 +383,125 @@ static int OthelloGame_init(OthelloGameObject* self, PyObject* args, PyObject* k
 static void OthelloGame_dealloc(OthelloGameObject* self) {
     Py_XDECREF(self->black_player);
     Py_XDECREF(self->white_player);
+    Py_XDECREF(self->black_stats);
+    Py_XDECREF(self->white_stats);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+static PyObject* OthelloGame_get_history(OthelloGameObject* self, void* closure) {
+    PyObject* history = PyList_New(self->ply);
+    if (history == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < self->ply; i++) {
+        PyObject* move;
+        if (self->history[i].move < 0) {
+            move = Py_None;
+            Py_INCREF(move);
+        } else if ((move = PyLong_FromLong(self->history[i].move)) == NULL) {
+            Py_DECREF(history);
+            return NULL;
+        }
+        PyList_SET_ITEM(history, i, move);
+    }
+
+    return history;
+}
+
+static PyObject* OthelloGame_get_black_board(OthelloGameObject* self, void* closure) {
+    return PyLong_FromUnsignedLongLong(self->state.black_board);
+}
+
+static PyObject* OthelloGame_get_white_board(OthelloGameObject* self, void* closure) {
+    return PyLong_FromUnsignedLongLong(self->state.white_board);
+}
+
+static PyObject* OthelloGame_get_black_to_move(OthelloGameObject* self, void* closure) {
+    return PyBool_FromLong(self->state.black_to_move);
+}
+
+static PyObject* OthelloGame_get_clock(OthelloGameObject* self, void* closure) {
+    if (!self->timed) {
+        Py_RETURN_NONE;
+    }
+    return Py_BuildValue("(dd)", self->time_left_ns[0] / 1e6, self->time_left_ns[1] / 1e6);
+}
+
+static PyObject* OthelloGame_get_lost_on_time(OthelloGameObject* self, void* closure) {
+    if (!self->time_forfeit) {
+        Py_RETURN_NONE;
+    }
+    return PyUnicode_FromString(self->time_forfeit > 0 ? "white" : "black");
+}
+
+static PyObject* OthelloGame_get_black_stats(OthelloGameObject* self, void* closure) {
+    if (self->black_stats == NULL) {
+        Py_RETURN_NONE;
+    }
+    Py_INCREF(self->black_stats);
+    return (PyObject*)self->black_stats;
+}
+
+static PyObject* OthelloGame_get_white_stats(OthelloGameObject* self, void* closure) {
+    if (self->white_stats == NULL) {
+        Py_RETURN_NONE;
+    }
+    Py_INCREF(self->white_stats);
+    return (PyObject*)self->white_stats;
+}
+
+static PyObject* OthelloGame_get_move_log(OthelloGameObject* self, void* closure) {
+    PyObject* log = PyList_New(self->move_count);
+    if (log == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < self->move_count; i++) {
+        const MoveRecord* record = &self->move_log[i];
+        PyObject* entry = Py_BuildValue("{s:s,s:N,s:i,s:K,s:K}",
+                                        "player", record->black ? "black" : "white",
+                                        "move", record->move >= 0 ? PyLong_FromLong(record->move) : (Py_INCREF(Py_None), Py_None),
+                                        "legal_moves", record->legal_moves,
+                                        "latency_ns", (unsigned long long)record->latency_ns,
+                                        "nodes", (unsigned long long)record->nodes);
+        if (entry == NULL) {
+            Py_DECREF(log);
+            return NULL;
+        }
+        PyList_SET_ITEM(log, i, entry);
+    }
+
+    return log;
+}
+
+static PyGetSetDef OthelloGame_getset[] = {
+    {"history", (getter)OthelloGame_get_history, NULL, "Moves played so far, None for a pass.", NULL},
+    {"black_board", (getter)OthelloGame_get_black_board, NULL, "Bitboard of the black discs.", NULL},
+    {"white_board", (getter)OthelloGame_get_white_board, NULL, "Bitboard of the white discs.", NULL},
+    {"black_to_move", (getter)OthelloGame_get_black_to_move, NULL, "True when black is the side to move.", NULL},
+    {"clock", (getter)OthelloGame_get_clock, NULL,
+     "Milliseconds left as (black, white), or None for an untimed game.", NULL},
+    {"lost_on_time", (getter)OthelloGame_get_lost_on_time, NULL,
+     "'black' or 'white' if that side ran out of time, otherwise None.", NULL},
+    {"black_stats", (getter)OthelloGame_get_black_stats, NULL, "MoveStats of the black player's decisions.", NULL},
+    {"white_stats", (getter)OthelloGame_get_white_stats, NULL, "MoveStats of the white player's decisions.", NULL},
+    {"move_log", (getter)OthelloGame_get_move_log, NULL,
+     "One dict per decision: player, move, legal_moves, latency_ns and nodes.", NULL},
+    {NULL}
+};
+
 static PyMethodDef OthelloGame_methods[] = {
     {"play", (PyCFunction)OthelloGame_play, METH_NOARGS,
      "Play the game until completion."},
+    {"legal_moves", (PyCFunction)OthelloGame_legal_moves, METH_NOARGS,
+     "Legal moves of the side to move; empty when it has to pass or the game is over."},
+    {"push", (PyCFunction)OthelloGame_push, METH_O,
+     "Plays a move for the side to move, or passes with None. Raises ValueError if it is not legal."},
+    {"pop", (PyCFunction)OthelloGame_pop, METH_NOARGS,
+     "Takes back the last move or pass and returns it."},
+    {"result", (PyCFunction)OthelloGame_result, METH_NOARGS,
+     "1 if black won, -1 if white won, 0 for a tie, None while the game is not over."},
     {NULL}
 };
 
@@ -404,6 +513,7 @@ PyTypeObject OthelloGameType = {
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_doc = "OthelloGame objects",
     .tp_methods = OthelloGame_methods,
+    .tp_getset = OthelloGame_getset,
     .tp_init = (initproc)OthelloGame_init,
     .tp_new = PyType_GenericNew,
 };
@@ -422,6 +532,12 @@ PyMODINIT_FUNC PyInit_othello(void) {
     if (PyType_Ready(&OthelloGameType) < 0)
         return NULL;
 
+    if (PyType_Ready(&BatchGameType) < 0)
+        return NULL;
+
+    if (PyType_Ready(&MoveStatsType) < 0)
+        return NULL;
+
     m = PyModule_Create(&othello_module);
     if (m == NULL)
         return NULL;
@@ -433,5 +549,19 @@ PyMODINIT_FUNC PyInit_othello(void) {
         return NULL;
     }
 
+    Py_INCREF(&BatchGameType);
+    if (PyModule_AddObject(m, "BatchGame", (PyObject*)&BatchGameType) < 0) {
+        Py_DECREF(&BatchGameType);
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    Py_INCREF(&MoveStatsType);
+    if (PyModule_AddObject(m, "MoveStats", (PyObject*)&MoveStatsType) < 0) {
+        Py_DECREF(&MoveStatsType);
+        Py_DECREF(m);
+        return NULL;
+    }
+
     return m;
 }
@@ -4,57 +4,70 @@
 #define OTHELLO_H
 
 #include <Python.h>
+#include "board.h"
+#include "move_stats.h"
 #include <stdint.h>
 #include <stdbool.h>
 
-#define BOARD_SIZE 8
-
-// Macro definitions for exporting/importing functions
-#ifdef _WIN32
-    #ifdef OTHELLO_EXPORTS
-        #define OTHELLO_API __declspec(dllexport)
-    #else
-        #define OTHELLO_API __declspec(dllimport)
-    #endif
-#else
-    #define OTHELLO_API
-#endif
+#define MAX_MOVE_RECORDS 128
+// Each move fills a square and two passes in a row end the game, so a game
+// never runs past 120 plies.
+#define MAX_GAME_PLIES 128
 
+// One call to a player's decide_move. move is -1 when the player passed.
 typedef struct {
-    int dr;
-    int dc;
-} Direction;
-
-extern const Direction DIRECTIONS[8];
+    int move;
+    bool black;
+    int legal_moves;
+    uint64_t latency_ns;
+    uint64_t nodes;
+} MoveRecord;
 
+// A position with the legal-move masks of both sides, computed once when the
+// position is reached. moves belongs to the side to move.
 typedef struct {
-    int moves[60];
-    int count;
-} MoveList;
+    uint64_t black_board;
+    uint64_t white_board;
+    uint64_t moves;
+    uint64_t opponent_moves;
+    bool black_to_move;
+} GameState;
 
+// The position before a ply and the move played from it, -1 for a pass.
 typedef struct {
-    int bits[64];
-    int count;
-} BitList;
+    GameState state;
+    int move;
+} HistoryEntry;
 
 typedef struct {
     PyObject_HEAD
-    uint64_t black_board;
-    uint64_t white_board;
+    GameState state;
+    HistoryEntry history[MAX_GAME_PLIES];
+    int ply;
     PyObject* black_player;
     PyObject* white_player;
-    PyObject* current_player;
     bool debug;
+    // Match clock, black first. Only play() runs it; increment_ns is added
+    // after every move made in time.
+    bool timed;
+    int64_t time_left_ns[2];
+    uint64_t increment_ns;
+    // Set to the winner (1 black, -1 white) when the other side runs out of time.
+    int time_forfeit;
+    MoveStatsObject* black_stats;
+    MoveStatsObject* white_stats;
+    bool black_reports_nodes;
+    bool white_reports_nodes;
+    MoveRecord move_log[MAX_MOVE_RECORDS];
+    int move_count;
 } OthelloGameObject;
 
 extern PyTypeObject OthelloGameType;
 
 // Function declarations
-OTHELLO_API void get_valid_moves(uint64_t player_board, uint64_t opponent_board, MoveList* move_list);
-OTHELLO_API void get_flipped_bits(int move, uint64_t player_board, uint64_t opponent_board, BitList* bit_list);
-OTHELLO_API int popcount64(uint64_t x);
-OTHELLO_API bool is_valid_move(int move, uint64_t player_board, uint64_t opponent_board);
-OTHELLO_API bool is_game_over(OthelloGameObject* self);
-OTHELLO_API int OthelloGame_apply_move(OthelloGameObject* self, int move);
+bool is_game_over(OthelloGameObject* self);
+// Plays move (-1 to pass) for the side to move and pushes it onto the history.
+// Returns 0 without changing anything when the move is not legal.
+int OthelloGame_apply_move(OthelloGameObject* self, int move);
 
 #endif /* OTHELLO_H */
@@ -0,0 +1,254 @@
+// players/batch.c
+
+#include "batch.h"
+#include "evaluate.h"
+#include "parallel.h"
+#include <string.h>
+
+typedef struct {
+    EvalFunc evaluate_func;
+    const char* strategy;
+    const uint64_t* player_boards;
+    const uint64_t* opponent_boards;
+    int32_t* scores;
+    int32_t* moves;
+    Py_ssize_t count;
+    int max_depth;
+    bool abp;
+    volatile long next;
+    volatile long failed;
+} BatchJob;
+
+static char buffer_kind(const Py_buffer* view) {
+    const char* format = view->format ? view->format : "B";
+    while (*format == '@' || *format == '=' || *format == '<' || *format == '>' || *format == '!') {
+        format++;
+    }
+    return *format;
+}
+
+static int get_batch_buffer(PyObject* obj, Py_buffer* view, const char* name, Py_ssize_t itemsize, const char* kinds, bool writable) {
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    if (PyObject_GetBuffer(obj, view, flags) < 0) {
+        return -1;
+    }
+
+    if (view->ndim > 1 || view->itemsize != itemsize || strchr(kinds, buffer_kind(view)) == NULL) {
+        PyErr_Format(PyExc_TypeError, "%s must be a 1-D contiguous array of %d-bit integers.", name, (int)itemsize * 8);
+        PyBuffer_Release(view);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void evaluate_batch_worker(void* ctx, int thread_index, int thread_count) {
+    BatchJob* job = (BatchJob*)ctx;
+    Py_ssize_t start = job->count * thread_index / thread_count;
+    Py_ssize_t end = job->count * (thread_index + 1) / thread_count;
+
+    for (Py_ssize_t i = start; i < end; i++) {
+        job->scores[i] = job->evaluate_func(job->player_boards[i], job->opponent_boards[i]);
+    }
+}
+
+static void search_batch_worker(void* ctx, int thread_index, int thread_count) {
+    BatchJob* job = (BatchJob*)ctx;
+    OthelloSearchOptions options;
+    othello_search_options_init(&options);
+    options.evaluator = job->strategy;
+    options.max_depth = job->max_depth;
+    options.alpha_beta = job->abp;
+
+    SearchContext searcher;
+    char error[256];
+    if (search_context_init(&searcher, &options, error, sizeof(error)) != OTHELLO_OK) {
+        parallel_fetch_add(&job->failed, 1);
+        return;
+    }
+
+    // Searches vary wildly in cost, so positions are handed out one at a time.
+    for (;;) {
+        Py_ssize_t i = (Py_ssize_t)parallel_fetch_add(&job->next, 1);
+        if (i >= job->count) {
+            break;
+        }
+
+        int best_move;
+        searcher.iter = 0;
+        job->scores[i] = search_root(&searcher, job->player_boards[i], job->opponent_boards[i], &best_move);
+        if (job->moves != NULL) {
+            job->moves[i] = best_move;
+        }
+    }
+    search_context_free(&searcher);
+}
+
+static int resolve_thread_count(int threads, Py_ssize_t count) {
+    if (threads <= 0) {
+        threads = default_thread_count();
+    }
+    if (threads > count) {
+        threads = (int)(count > 0 ? count : 1);
+    }
+    return threads;
+}
+
+PyObject* players_evaluate_batch(PyObject* module, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"strategy", "player_boards", "opponent_boards", "out", "threads", NULL};
+
+    const char* strategy;
+    PyObject* player_obj;
+    PyObject* opponent_obj;
+    PyObject* out_obj;
+    int threads = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "sOOO|i", kwlist, &strategy, &player_obj, &opponent_obj, &out_obj, &threads)) {
+        return NULL;
+    }
+
+    EvalFunc evaluate_func = find_eval_func(strategy);
+    if (evaluate_func == NULL) {
+        PyErr_Format(PyExc_ValueError, "Unknown evaluation strategy: '%s'", strategy);
+        return NULL;
+    }
+
+    Py_buffer player_view, opponent_view, out_view;
+    if (get_batch_buffer(player_obj, &player_view, "player_boards", 8, "QqLl", false) < 0) {
+        return NULL;
+    }
+    if (get_batch_buffer(opponent_obj, &opponent_view, "opponent_boards", 8, "QqLl", false) < 0) {
+        PyBuffer_Release(&player_view);
+        return NULL;
+    }
+    if (get_batch_buffer(out_obj, &out_view, "out", 4, "il", true) < 0) {
+        PyBuffer_Release(&player_view);
+        PyBuffer_Release(&opponent_view);
+        return NULL;
+    }
+
+    Py_ssize_t count = player_view.len / 8;
+    if (opponent_view.len / 8 != count || out_view.len / 4 != count) {
+        PyErr_SetString(PyExc_ValueError, "player_boards, opponent_boards and out must have the same length.");
+        PyBuffer_Release(&player_view);
+        PyBuffer_Release(&opponent_view);
+        PyBuffer_Release(&out_view);
+        return NULL;
+    }
+
+    BatchJob job = {
+        .evaluate_func = evaluate_func,
+        .player_boards = (const uint64_t*)player_view.buf,
+        .opponent_boards = (const uint64_t*)opponent_view.buf,
+        .scores = (int32_t*)out_view.buf,
+        .count = count,
+    };
+    int thread_count = resolve_thread_count(threads, count);
+    int status;
+
+    Py_BEGIN_ALLOW_THREADS
+    status = run_parallel(thread_count, evaluate_batch_worker, &job);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&player_view);
+    PyBuffer_Release(&opponent_view);
+    PyBuffer_Release(&out_view);
+
+    if (status < 0) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* players_search_batch(PyObject* module, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"strategy", "depth", "player_boards", "opponent_boards", "scores", "moves", "abp", "threads", NULL};
+
+    const char* strategy;
+    int depth;
+    PyObject* player_obj;
+    PyObject* opponent_obj;
+    PyObject* scores_obj;
+    PyObject* moves_obj = Py_None;
+    int abp = 1;
+    int threads = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "siOOO|Opi", kwlist, &strategy, &depth, &player_obj, &opponent_obj,
+                                     &scores_obj, &moves_obj, &abp, &threads)) {
+        return NULL;
+    }
+
+    if (depth < 1) {
+        PyErr_SetString(PyExc_ValueError, "depth must be at least 1.");
+        return NULL;
+    }
+
+    EvalFunc evaluate_func = find_eval_func(strategy);
+    if (evaluate_func == NULL) {
+        PyErr_Format(PyExc_ValueError, "Unknown evaluation strategy: '%s'", strategy);
+        return NULL;
+    }
+
+    Py_buffer player_view, opponent_view, scores_view, moves_view;
+    bool has_moves = moves_obj != Py_None;
+    if (get_batch_buffer(player_obj, &player_view, "player_boards", 8, "QqLl", false) < 0) {
+        return NULL;
+    }
+    if (get_batch_buffer(opponent_obj, &opponent_view, "opponent_boards", 8, "QqLl", false) < 0) {
+        PyBuffer_Release(&player_view);
+        return NULL;
+    }
+    if (get_batch_buffer(scores_obj, &scores_view, "scores", 4, "il", true) < 0) {
+        PyBuffer_Release(&player_view);
+        PyBuffer_Release(&opponent_view);
+        return NULL;
+    }
+    if (has_moves && get_batch_buffer(moves_obj, &moves_view, "moves", 4, "il", true) < 0) {
+        PyBuffer_Release(&player_view);
+        PyBuffer_Release(&opponent_view);
+        PyBuffer_Release(&scores_view);
+        return NULL;
+    }
+
+    Py_ssize_t count = player_view.len / 8;
+    if (opponent_view.len / 8 != count || scores_view.len / 4 != count || (has_moves && moves_view.len / 4 != count)) {
+        PyErr_SetString(PyExc_ValueError, "All board and result arrays must have the same length.");
+        PyBuffer_Release(&player_view);
+        PyBuffer_Release(&opponent_view);
+        PyBuffer_Release(&scores_view);
+        if (has_moves) {
+            PyBuffer_Release(&moves_view);
+        }
+        return NULL;
+    }
+
+    BatchJob job = {
+        .strategy = strategy,
+        .player_boards = (const uint64_t*)player_view.buf,
+        .opponent_boards = (const uint64_t*)opponent_view.buf,
+        .scores = (int32_t*)scores_view.buf,
+        .moves = has_moves ? (int32_t*)moves_view.buf : NULL,
+        .count = count,
+        .max_depth = depth,
+        .abp = abp ? true : false,
+        .next = 0,
+        .failed = 0,
+    };
+    int thread_count = resolve_thread_count(threads, count);
+    int status;
+
+    Py_BEGIN_ALLOW_THREADS
+    status = run_parallel(thread_count, search_batch_worker, &job);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&player_view);
+    PyBuffer_Release(&opponent_view);
+    PyBuffer_Release(&scores_view);
+    if (has_moves) {
+        PyBuffer_Release(&moves_view);
+    }
+
+    if (status < 0 || job.failed > 0) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
@@ -0,0 +1,11 @@
+// players/batch.h
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <Python.h>
+
+PyObject* players_evaluate_batch(PyObject* module, PyObject* args, PyObject* kwds);
+PyObject* players_search_batch(PyObject* module, PyObject* args, PyObject* kwds);
+
+#endif /* BATCH_H */
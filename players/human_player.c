@@ -1,14 +1,17 @@
 #include "human_player.h"
-#include "othello.h"
+#include "board.h"
 #include <stdio.h>
 
 static PyObject* HumanPlayer_decide_move(PyObject* self, PyObject* args) {
     unsigned long long num_moves;
     unsigned long long player_board;
     unsigned long long opponent_board;
+    double time_left_ms = -1.0;
+    double increment_ms = 0.0;
 
-    if (!PyArg_ParseTuple(args, "KKK", &num_moves, &player_board, &opponent_board)) {
-        PyErr_SetString(PyExc_TypeError, "decide_move() arguments must be (num_moves, player_board, opponent_board).");
+    if (!PyArg_ParseTuple(args, "KKK|dd", &num_moves, &player_board, &opponent_board, &time_left_ms, &increment_ms)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "decide_move() arguments must be (num_moves, player_board, opponent_board[, time_left_ms, increment_ms]).");
         return NULL;
     }
 
@@ -31,6 +34,9 @@ static PyObject* HumanPlayer_decide_move(PyObject* self, PyObject* args) {
         printf("[%d]: Row %d, Col %d (Board position: %d)\n", i, row, col, move);
     }
 
+    if (time_left_ms >= 0.0) {
+        printf("Time left: %.1f s (+%.1f s per move)\n", time_left_ms / 1000.0, increment_ms / 1000.0);
+    }
     printf("Enter the index of your move: ");
     fflush(stdout);
 
@@ -1,487 +1,335 @@
 #include "minimax_player.h"
-#include "othello.h"
+#include "search_handle.h"
 #include <limits.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <time.h>
 #include <stdbool.h>
-#include <string.h>
 #include <Python.h>
 
-static int win_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int material_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int mobility_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int positional_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int corner_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int edge_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int frontier_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int parity_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int random_evaluate(uint64_t player_board, uint64_t opponent_board);
-static int combined_evaluate(uint64_t player_board, uint64_t opponent_board);
-
-static inline bool is_terminal_state(uint64_t player_board, uint64_t opponent_board) {
-    MoveList player_moves;
-    get_valid_moves(player_board, opponent_board, &player_moves);
-
-    MoveList opponent_moves;
-    get_valid_moves(opponent_board, player_board, &opponent_moves);
-
-    return (player_moves.count == 0 && opponent_moves.count == 0);
+bool minimax_player_claim(MiniMaxPlayer* player) {
+    if (player->searching) {
+        PyErr_SetString(PyExc_RuntimeError, "This MiniMaxPlayer is already searching.");
+        return false;
+    }
+    player->searching = true;
+    return true;
 }
 
-static int minimax(uint64_t player_board, uint64_t opponent_board, int depth, bool maximizing_player, MiniMaxPlayer* self) {
-    self->iter++;
+static PyObject* MiniMaxPlayer_decide_move(PyObject* self_obj, PyObject* args) {
+    MiniMaxPlayer* player = (MiniMaxPlayer*)self_obj;
+    unsigned long long num_moves;
+    unsigned long long player_board;
+    unsigned long long opponent_board;
+    double time_left_ms = -1.0;
+    double increment_ms = 0.0;
 
-    if (self->debug && self->iter % 1000000 == 0) {
-        printf("Iteration: %d\n", self->iter);
+    if (!PyArg_ParseTuple(args, "KKK|dd", &num_moves, &player_board, &opponent_board, &time_left_ms, &increment_ms)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "decide_move() arguments must be (num_moves, player_board, opponent_board[, time_left_ms, increment_ms]).");
+        return NULL;
     }
 
-    if (depth == 0 || is_terminal_state(player_board, opponent_board)) {
-        return self->evaluate_func(player_board, opponent_board);
+    if (num_moves == 0) {
+        Py_RETURN_NONE;
     }
-
-    MoveList valid_moves;
-    get_valid_moves(player_board, opponent_board, &valid_moves);
-
-    if (valid_moves.count == 0) {
-        return minimax(opponent_board, player_board, depth - 1, !maximizing_player, self);
+    if (!minimax_player_claim(player)) {
+        return NULL;
     }
 
-    int best_value = maximizing_player ? INT_MIN : INT_MAX;
-
-    for (int i = 0; i < valid_moves.count; i++) {
-        int move = valid_moves.moves[i];
-
-        uint64_t new_player_board = player_board;
-        uint64_t new_opponent_board = opponent_board;
-
-        BitList bits_to_flip;
-        get_flipped_bits(move, player_board, opponent_board, &bits_to_flip);
-        new_player_board |= 1ULL << move;
-        for (int j = 0; j < bits_to_flip.count; j++) {
-            int bit = bits_to_flip.bits[j];
-            new_player_board |= 1ULL << bit;
-            new_opponent_board &= ~(1ULL << bit);
-        }
-
-        int eval = minimax(new_opponent_board, new_player_board, depth - 1, !maximizing_player, self);
-
-        if (maximizing_player) {
-            if (eval > best_value) {
-                best_value = eval;
-            }
-        } else {
-            if (eval < best_value) {
-                best_value = eval;
-            }
-        }
+    player->search.iter = 0;
+    player->search.stop_requested = 0;
+
+    int best_move;
+    Py_BEGIN_ALLOW_THREADS
+    if (time_left_ms >= 0.0) {
+        // On the clock: deepen up to max_depth for as long as the budget allows.
+        TimeBudget budget;
+        int empties = 64 - popcount64(player_board | opponent_board);
+        time_budget_init(&budget, (uint64_t)(time_left_ms * 1e6), (uint64_t)(increment_ms * 1e6), empties,
+                         (uint64_t)(player->move_overhead_ms * 1e6));
+
+        RootMoveList root_moves;
+        player->search.budget = &budget;
+        search_iterative(&player->search, player_board, opponent_board, &root_moves);
+        player->search.budget = NULL;
+        best_move = root_moves.best_index >= 0 ? root_moves.moves[root_moves.best_index].move : -1;
+    } else {
+        search_root(&player->search, player_board, opponent_board, &best_move);
     }
+    Py_END_ALLOW_THREADS
+    player->searching = false;
 
-    return best_value;
+    if (best_move == -1) {
+        Py_RETURN_NONE;
+    } else {
+        return PyLong_FromLong(best_move);
+    }
 }
 
-static int minimax_abp(uint64_t player_board, uint64_t opponent_board, int depth, int alpha, int beta, bool maximizing_player, MiniMaxPlayer* self) {
-    self->iter++;
+static PyObject* MiniMaxPlayer_analyze(PyObject* self_obj, PyObject* args) {
+    MiniMaxPlayer* player = (MiniMaxPlayer*)self_obj;
+    unsigned long long player_board;
+    unsigned long long opponent_board;
 
-    if (self->debug && self->iter % 1000000 == 0) {
-        printf("Iteration: %d\n", self->iter);
+    if (!PyArg_ParseTuple(args, "KK", &player_board, &opponent_board)) {
+        PyErr_SetString(PyExc_TypeError, "analyze() arguments must be (player_board, opponent_board).");
+        return NULL;
     }
 
-    if (depth == 0 || is_terminal_state(player_board, opponent_board)) {
-        return self->evaluate_func(player_board, opponent_board);
+    if (!minimax_player_claim(player)) {
+        return NULL;
     }
+    player->search.iter = 0;
+    player->search.stop_requested = 0;
 
-    MoveList valid_moves;
-    get_valid_moves(player_board, opponent_board, &valid_moves);
+    RootMoveList root_moves;
+    Py_BEGIN_ALLOW_THREADS
+    search_analyze(&player->search, player_board, opponent_board, &root_moves);
+    Py_END_ALLOW_THREADS
+    player->searching = false;
 
-    if (valid_moves.count == 0) {
-        return minimax_abp(opponent_board, player_board, depth - 1, alpha, beta, !maximizing_player, self);
+    PyObject* result = PyList_New(root_moves.count);
+    if (result == NULL) {
+        return NULL;
     }
 
-    int best_value = maximizing_player ? INT_MIN : INT_MAX;
-
-    for (int i = 0; i < valid_moves.count; i++) {
-        int move = valid_moves.moves[i];
-
-        uint64_t new_player_board = player_board;
-        uint64_t new_opponent_board = opponent_board;
-
-        BitList bits_to_flip;
-        get_flipped_bits(move, player_board, opponent_board, &bits_to_flip);
-        new_player_board |= 1ULL << move;
-        for (int j = 0; j < bits_to_flip.count; j++) {
-            int bit = bits_to_flip.bits[j];
-            new_player_board |= 1ULL << bit;
-            new_opponent_board &= ~(1ULL << bit);
+    for (int i = 0; i < root_moves.count; i++) {
+        const RootMove* root_move = &root_moves.moves[i];
+        PyObject* pv = PyList_New(root_move->pv_length);
+        if (pv == NULL) {
+            Py_DECREF(result);
+            return NULL;
         }
-
-        int eval = minimax_abp(new_opponent_board, new_player_board, depth - 1, alpha, beta, !maximizing_player, self);
-
-        if (maximizing_player) {
-            if (eval > best_value) {
-                best_value = eval;
-            }
-            if (best_value > alpha) {
-                alpha = best_value;
+        for (int j = 0; j < root_move->pv_length; j++) {
+            PyObject* move;
+            if (root_move->pv[j] == OTHELLO_PASS) {
+                move = Py_None;
+                Py_INCREF(move);
+            } else {
+                move = PyLong_FromLong(root_move->pv[j]);
             }
-            if (beta <= alpha) {
-                break;
-            }
-        } else {
-            if (eval < best_value) {
-                best_value = eval;
-            }
-            if (best_value < beta) {
-                beta = best_value;
-            }
-            if (beta <= alpha) {
-                break;
-            }
-        }
-    }
-
-    return best_value;
-}
-
-static int win_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int player_count = popcount64(player_board);
-    int opponent_count = popcount64(opponent_board);
-    bool is_over = is_terminal_state(player_board, opponent_board);
-
-    if (is_over) {
-        if (player_count > opponent_count) {
-            return INT_MAX;
-        } else if (player_count < opponent_count) {
-            return INT_MIN + 1;
-        }
-    }
-
-    return 0;
-}
-
-static int material_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int player_count = popcount64(player_board);
-    int opponent_count = popcount64(opponent_board);
-    
-    return player_count - opponent_count;
-}
-
-static int mobility_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    MoveList player_moves;
-    MoveList opponent_moves;
-    get_valid_moves(player_board, opponent_board, &player_moves);
-    get_valid_moves(opponent_board, player_board, &opponent_moves);
-
-    int player_mobility = player_moves.count;
-    int opponent_mobility = opponent_moves.count;
-    
-    return player_mobility - opponent_mobility;
-}
-
-static const int POSITION_VALUES[8][8] = {
-    {100, -50, 2, 2, 2, 2, -50, 100},
-    {-50, -100, 1, 1, 1, 1, -100, -50},
-    {2, 1, 0, 0, 0, 0, 1, 2},
-    {2, 1, 0, 0, 0, 0, 1, 2},
-    {2, 1, 0, 0, 0, 0, 1, 2},
-    {2, 1, 0, 0, 0, 0, 1, 2},
-    {-50, -100, 1, 1, 1, 1, -100, -50},
-    {100, -50, 2, 2, 2, 2, -50, 100}
-};
-
-static int positional_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int score = 0;
-
-    for (int i = 0; i < 64; i++) {
-        int row = i / 8;
-        int col = i % 8;
-        if (player_board & (1ULL << i)) {
-            score += POSITION_VALUES[row][col];
-        } else if (opponent_board & (1ULL << i)) {
-            score -= POSITION_VALUES[row][col];
+            PyList_SET_ITEM(pv, j, move);
         }
-    }
-
-    return score;
-}
-
-static const int CORNER_SQUARES[4] = {0, 7, 56, 63};
-
-static int corner_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int score = 0;
 
-    for (int i = 0; i < 4; i++) {
-        int row = i / 8;
-        int col = i % 8;
-        uint64_t mask = 1ULL << CORNER_SQUARES[i];
-        if (player_board & mask) {
-            score += 1;
-        } else if (opponent_board & mask) {
-            score -= 1;
+        PyObject* entry = Py_BuildValue("(iiN)", root_move->move, root_move->score, pv);
+        if (entry == NULL) {
+            Py_DECREF(result);
+            return NULL;
         }
+        PyList_SET_ITEM(result, i, entry);
     }
 
-    return score;
+    return result;
 }
 
-static const int EDGE_SQUARES[24] = {
-    1, 2, 3, 4, 5, 6,
-    8, 16, 24, 32, 40, 48,
-    55, 54, 53, 52, 51, 50,
-    57, 58, 59, 60, 61, 62
-};
-
-static int edge_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int score = 0;
-
-    for (int i = 0; i < 24; i++) {
-        int row = i / 8;
-        int col = i % 8;
-        uint64_t mask = 1ULL << EDGE_SQUARES[i];
-        if (player_board & mask) {
-            score += 1;
-        } else if (opponent_board & mask) {
-            score -= 1;
-        }
-    }
-
-    return score;
-}
-
-static int frontier_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    uint64_t empty = ~(player_board | opponent_board);
-
-    uint64_t adjacent_to_empty = 0;
-    adjacent_to_empty |= empty << 8; // North
-    adjacent_to_empty |= empty >> 8; // South
-    adjacent_to_empty |= (empty & 0xFEFEFEFEFEFEFEFEULL) << 1;  // East
-    adjacent_to_empty |= (empty & 0x7F7F7F7F7F7F7F7FULL) >> 1;  // West
-    adjacent_to_empty |= (empty & 0xFEFEFEFEFEFEFEFEULL) << 9;  // Northeast
-    adjacent_to_empty |= (empty & 0x7F7F7F7F7F7F7F7FULL) << 7;  // Northwest
-    adjacent_to_empty |= (empty & 0xFEFEFEFEFEFEFEFEULL) >> 7;  // Southeast
-    adjacent_to_empty |= (empty & 0x7F7F7F7F7F7F7F7FULL) >> 9;  // Southwest
-
-    int player_frontier = popcount64(player_board & adjacent_to_empty);
-    int opponent_frontier = popcount64(opponent_board & adjacent_to_empty);
-
-    return player_frontier - opponent_frontier;
-}
-
-static int parity_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int empty_squares = popcount64(~(player_board | opponent_board));
-
-    if (empty_squares % 2 == 0) {
-        return 1;
-    } else {
-        return -1;
-    }
-}
+static PyObject* MiniMaxPlayer_start_search(PyObject* self_obj, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"player_board", "opponent_board", "time_ms", NULL};
+    unsigned long long player_board;
+    unsigned long long opponent_board;
+    int time_ms = 0;
 
-static int combined_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    int win = win_evaluate(player_board, opponent_board);
-    if (win) {
-        return win;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "KK|i", kwlist, &player_board, &opponent_board, &time_ms)) {
+        return NULL;
     }
-
-    int total_pieces = popcount64(player_board) + popcount64(opponent_board);
-    int material_weight, mobility_weight, positional_weight, corner_weight, edge_weight, frontier_weight, parity_weight;
-    int normalization_factor;
-
-    if (total_pieces <= 15) {
-        material_weight = 1;
-        mobility_weight = 4;
-        positional_weight = 4;
-        corner_weight = 5;
-        edge_weight = 4;
-        frontier_weight = 1;
-        parity_weight = 1;
-    } else if (total_pieces <= 45) {
-        material_weight = 3;
-        mobility_weight = 4;
-        positional_weight = 4;
-        corner_weight = 5;
-        edge_weight = 4;
-        frontier_weight = 2;
-        parity_weight = 1;
-    } else {
-        material_weight = 4;
-        mobility_weight = 4;
-        positional_weight = 4;
-        corner_weight = 5;
-        edge_weight = 4;
-        frontier_weight = 2;
-        parity_weight = 2;
+    if (time_ms < 0) {
+        PyErr_SetString(PyExc_ValueError, "time_ms must not be negative.");
+        return NULL;
     }
-
-    int material = material_evaluate(player_board, opponent_board);
-    int mobility = mobility_evaluate(player_board, opponent_board);
-    int positional = positional_evaluate(player_board, opponent_board);
-    int corner = corner_evaluate(player_board, opponent_board);
-    int edge = edge_evaluate(player_board, opponent_board);
-    int frontier = frontier_evaluate(player_board, opponent_board);
-    int parity = parity_evaluate(player_board, opponent_board);
-
-    int total_score =
-        material * material_weight +
-         mobility * mobility_weight +
-         positional * positional_weight +
-         corner * corner_weight +
-         edge * edge_weight +
-         frontier * frontier_weight +
-         parity * parity_weight;
-
-    return total_score;
+    return search_handle_start((MiniMaxPlayer*)self_obj, player_board, opponent_board, time_ms);
 }
 
-
-static int random_evaluate(uint64_t player_board, uint64_t opponent_board) {
-    static bool seeded = false;
-    if (!seeded) {
-        srand((unsigned int)time(NULL));
-        seeded = true;
+static PyObject* MiniMaxPlayer_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+    MiniMaxPlayer* self = (MiniMaxPlayer*)type->tp_alloc(type, 0);
+    if (self != NULL) {
+        self->search.iter = 0;
     }
-    int min_value = -50;
-    int max_value = 50;
-    int range = max_value - min_value + 1;
-    int random_value = rand() % range + min_value;
-    return random_value;
+    return (PyObject*)self;
 }
 
-typedef struct {
-    const char* name;
-    int (*func)(uint64_t, uint64_t);
-} EvalFuncMapping;
-
-static EvalFuncMapping eval_functions[] = {
-    {"win_evaluate", win_evaluate},
-    {"material_evaluate", material_evaluate},
-    {"mobility_evaluate", mobility_evaluate},
-    {"positional_evaluate", positional_evaluate},
-    {"corner_evaluate", corner_evaluate},
-    {"edge_evaluate", edge_evaluate},
-    {"frontier_evaluate", frontier_evaluate},
-    {"parity_evaluate", parity_evaluate},
-    {"combined_evaluate", combined_evaluate},
-    {"random_evaluate", random_evaluate},
-    {NULL, NULL}
-};
-
-static PyObject* MiniMaxPlayer_decide_move(PyObject* self_obj, PyObject* args) {
-    MiniMaxPlayer* player = (MiniMaxPlayer*)self_obj;
-    unsigned long long num_moves;
-    unsigned long long player_board;
-    unsigned long long opponent_board;
-
-    if (!PyArg_ParseTuple(args, "KKK", &num_moves, &player_board, &opponent_board)) {
-        PyErr_SetString(PyExc_TypeError, "decide_move() arguments must be (num_moves, player_board, opponent_board).");
+// Reads [(term, weight), ...], where weight is one int for every phase or an
+// (opening, midgame, endgame) triple. The term names point into *items, which
+// the caller releases once it is done with them: for an iterator that is not a
+// list or tuple, *items holds the only reference to the entries.
+static OthelloEvalTerm* parse_eval_terms(PyObject* spec, int* count, PyObject** items_out) {
+    PyObject* items = PySequence_Fast(spec, "evaluation_strategy must be a name or a list of (term, weight) pairs.");
+    if (items == NULL) {
         return NULL;
     }
 
-    if (num_moves == 0) {
-        Py_RETURN_NONE;
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(items);
+    if (size == 0) {
+        Py_DECREF(items);
+        PyErr_SetString(PyExc_ValueError, "evaluation_strategy needs at least one term.");
+        return NULL;
     }
-
-    player->iter = 0;
-
-    MoveList valid_moves;
-    get_valid_moves(player_board, opponent_board, &valid_moves);
-
-    if (valid_moves.count == 0) {
-        Py_RETURN_NONE;
+    OthelloEvalTerm* terms = (OthelloEvalTerm*)PyMem_Malloc(sizeof(OthelloEvalTerm) * (size_t)size);
+    if (terms == NULL) {
+        Py_DECREF(items);
+        PyErr_NoMemory();
+        return NULL;
     }
 
-    int best_move = -1;
-    int best_score = INT_MIN;
-
-    for (int i = 0; i < valid_moves.count; i++) {
-        int move = valid_moves.moves[i];
-
-        uint64_t new_player_board = player_board;
-        uint64_t new_opponent_board = opponent_board;
-
-        BitList bits_to_flip;
-        get_flipped_bits(move, player_board, opponent_board, &bits_to_flip);
-        new_player_board |= 1ULL << move;
-        for (int j = 0; j < bits_to_flip.count; j++) {
-            int bit = bits_to_flip.bits[j];
-            new_player_board |= 1ULL << bit;
-            new_opponent_board &= ~(1ULL << bit);
+    for (Py_ssize_t i = 0; i < size; i++) {
+        PyObject* entry = PySequence_Fast_GET_ITEM(items, i);
+        PyObject* weight;
+        if (!PyTuple_Check(entry) || !PyArg_ParseTuple(entry, "sO", &terms[i].term, &weight)) {
+            PyErr_SetString(PyExc_TypeError, "evaluation_strategy entries must be (term, weight) pairs.");
+            goto fail;
         }
 
-        int score;
-        if (player->abp) {
-            score = minimax_abp(new_opponent_board, new_player_board, player->max_depth - 1, INT_MIN, INT_MAX, false, player);
-        } else {
-            score = minimax(new_opponent_board, new_player_board, player->max_depth - 1, false, player);
+        if (PyLong_Check(weight)) {
+            long value = PyLong_AsLong(weight);
+            if ((value == -1 && PyErr_Occurred()) || value < INT_MIN || value > INT_MAX) {
+                PyErr_SetString(PyExc_OverflowError, "weights must fit in an int.");
+                goto fail;
+            }
+            for (int phase = 0; phase < OTHELLO_EVAL_PHASES; phase++) {
+                terms[i].weights[phase] = (int)value;
+            }
+        } else if (!PyTuple_Check(weight) ||
+                   !PyArg_ParseTuple(weight, "iii", &terms[i].weights[0], &terms[i].weights[1], &terms[i].weights[2])) {
+            PyErr_SetString(PyExc_TypeError, "weights must be an int or an (opening, midgame, endgame) tuple of ints.");
+            goto fail;
         }
-
-        if (score > best_score) {
-            best_score = score;
-            best_move = move;
+        if (PyErr_Occurred()) {
+            goto fail;
         }
     }
 
-    if (best_move == -1) {
-        Py_RETURN_NONE;
-    } else {
-        return PyLong_FromLong(best_move);
-    }
-}
+    *count = (int)size;
+    *items_out = items;
+    return terms;
 
-static PyObject* MiniMaxPlayer_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
-    MiniMaxPlayer* self = (MiniMaxPlayer*)type->tp_alloc(type, 0);
-    if (self != NULL) {
-        self->iter = 0;
-    }
-    return (PyObject*)self;
+fail:
+    PyMem_Free(terms);
+    Py_DECREF(items);
+    return NULL;
 }
 
 static int MiniMaxPlayer_init(MiniMaxPlayer* self, PyObject* args, PyObject* kwds) {
-    static char* kwlist[] = {"max_depth", "debug", "evaluation_strategy", "abp", NULL};
+    static char* kwlist[] = {"max_depth", "debug", "evaluation_strategy", "abp", "nnue_weights", "mpc_params", "mpc_confidence", "endgame_empties",
+                             "move_overhead_ms", "shared_table", "eval_params", "eval_cache_mb", NULL};
 
     int max_depth = 3;
     int debug = 0;
-    const char* eval_strategy = "combined_evaluate";
+    PyObject* eval_strategy = NULL;
     int abp = 1;
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|iisi", kwlist, &max_depth, &debug, &eval_strategy, &abp)) {
+    const char* nnue_weights = NULL;
+    const char* mpc_params = NULL;
+    double mpc_confidence = 1.5;
+    int endgame_empties = 0;
+    double move_overhead_ms = DEFAULT_MOVE_OVERHEAD_MS;
+    const char* shared_table = NULL;
+    const char* eval_params = NULL;
+    int eval_cache_mb = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|iiOizzdidzzi", kwlist, &max_depth, &debug, &eval_strategy, &abp, &nnue_weights,
+                                     &mpc_params, &mpc_confidence, &endgame_empties, &move_overhead_ms, &shared_table,
+                                     &eval_params, &eval_cache_mb)) {
         return -1;
     }
-
-    self->max_depth = max_depth;
-    self->debug = debug ? true : false;
-    self->abp = abp ? true : false;
-
-    bool found = false;
-    for (int i = 0; eval_functions[i].name != NULL; i++) {
-        if (strcmp(eval_strategy, eval_functions[i].name) == 0) {
-            self->evaluate_func = eval_functions[i].func;
-            found = true;
-            break;
+    if (self->searching) {
+        PyErr_SetString(PyExc_RuntimeError, "Cannot reinitialize a MiniMaxPlayer while it is searching.");
+        return -1;
+    }
+    if (move_overhead_ms < 0.0) {
+        PyErr_SetString(PyExc_ValueError, "move_overhead_ms must not be negative.");
+        return -1;
+    }
+    self->move_overhead_ms = move_overhead_ms;
+
+    OthelloSearchOptions options;
+    othello_search_options_init(&options);
+    options.max_depth = max_depth;
+    options.debug = debug ? true : false;
+    options.alpha_beta = abp ? true : false;
+    OthelloEvalTerm* eval_terms = NULL;
+    PyObject* eval_items = NULL;
+    if (eval_strategy != NULL && PyUnicode_Check(eval_strategy)) {
+        options.evaluator = PyUnicode_AsUTF8(eval_strategy);
+        if (options.evaluator == NULL) {
+            return -1;
         }
+    } else if (eval_strategy != NULL) {
+        eval_terms = parse_eval_terms(eval_strategy, &options.eval_term_count, &eval_items);
+        if (eval_terms == NULL) {
+            return -1;
+        }
+        options.eval_terms = eval_terms;
     }
-
-    if (!found) {
-        PyErr_Format(PyExc_ValueError, "Unknown evaluation strategy: '%s'", eval_strategy);
+    options.nnue_weights = nnue_weights;
+    options.mpc_params = mpc_params;
+    options.mpc_confidence = mpc_confidence;
+    options.endgame_empties = endgame_empties;
+    options.shared_table = shared_table;
+    options.eval_params = eval_params;
+    options.eval_cache_mb = eval_cache_mb;
+
+    search_context_free(&self->search);
+
+    char error[256];
+    OthelloStatus status = search_context_init(&self->search, &options, error, sizeof(error));
+    PyMem_Free(eval_terms);
+    Py_XDECREF(eval_items);
+    if (status == OTHELLO_ERROR_OUT_OF_MEMORY) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (status == OTHELLO_ERROR_IO) {
+        PyErr_SetString(PyExc_OSError, error);
+        return -1;
+    }
+    if (status != OTHELLO_OK) {
+        PyErr_SetString(PyExc_ValueError, error);
         return -1;
     }
 
     return 0;
 }
 
+static void MiniMaxPlayer_dealloc(MiniMaxPlayer* self) {
+    search_context_free(&self->search);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
 static PyMethodDef MiniMaxPlayer_methods[] = {
     {"decide_move", (PyCFunction)MiniMaxPlayer_decide_move, METH_VARARGS,
      "Selects the optimal move based on the Minimax with Alpha-Beta Pruning algorithm."},
+    {"analyze", (PyCFunction)MiniMaxPlayer_analyze, METH_VARARGS,
+     "Scores every legal move as a list of (move, score, principal_variation), best first."},
+    {"start_search", (PyCFunction)MiniMaxPlayer_start_search, METH_VARARGS | METH_KEYWORDS,
+     "start_search(player_board, opponent_board, time_ms=0)\n"
+     "Deepens iteratively up to max_depth (or for time_ms) on a native thread without the GIL and returns a SearchHandle."},
     {NULL, NULL, 0, NULL}
 };
 
+static PyObject* MiniMaxPlayer_get_nodes(MiniMaxPlayer* self, void* closure) {
+    return PyLong_FromUnsignedLongLong(self->search.iter);
+}
+
+static PyObject* MiniMaxPlayer_get_eval_cache_stats(MiniMaxPlayer* self, void* closure) {
+    const EvalCache* cache = self->search.eval_cache;
+    if (cache == NULL) {
+        Py_RETURN_NONE;
+    }
+    return Py_BuildValue("{s:K,s:K,s:K}", "hits", (unsigned long long)cache->hits, "misses",
+                         (unsigned long long)cache->misses, "entries", (unsigned long long)(cache->mask + 1));
+}
+
+static PyGetSetDef MiniMaxPlayer_getset[] = {
+    {"nodes", (getter)MiniMaxPlayer_get_nodes, NULL, "Nodes searched by the last decide_move or analyze call.", NULL},
+    {"eval_cache_stats", (getter)MiniMaxPlayer_get_eval_cache_stats, NULL,
+     "Leaf cache hits and misses since the player was created and its entry count, or None without eval_cache_mb.", NULL},
+    {NULL}
+};
+
 PyTypeObject MiniMaxPlayerType = {
     PyVarObject_HEAD_INIT(NULL, 0)
     .tp_name = "players.MiniMaxPlayer",
     .tp_basicsize = sizeof(MiniMaxPlayer),
+    .tp_dealloc = (destructor)MiniMaxPlayer_dealloc,
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_doc = "Player using a minimax strategy with alpha-beta pruning",
     .tp_methods = MiniMaxPlayer_methods,
+    .tp_getset = MiniMaxPlayer_getset,
     .tp_new = MiniMaxPlayer_new,
     .tp_init = (initproc)MiniMaxPlayer_init,
 };
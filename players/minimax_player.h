@@ -2,19 +2,26 @@
 #define MINIMAX_PLAYER_H
 
 #include "players.h"
-#include <stdbool.h>
-#include <stdint.h>
+#include "search.h"
 #include <Python.h>
 
+// Clock time kept back per move for the game's own bookkeeping and the
+// search's stop latency; see the README for how it was measured.
+#define DEFAULT_MOVE_OVERHEAD_MS 1.0
+
 typedef struct {
     BasicPlayer base;
-    int max_depth;
-    bool debug;
-    int iter;
-    bool abp;
-    int (*evaluate_func)(uint64_t player_board, uint64_t opponent_board);
+    SearchContext search;
+    double move_overhead_ms;
+    // Set while a search runs with the GIL released; the context must not be
+    // touched from Python until it clears.
+    bool searching;
 } MiniMaxPlayer;
 
+// Claims player->search for a search, or raises RuntimeError and returns
+// false when another one is running.
+bool minimax_player_claim(MiniMaxPlayer* player);
+
 extern PyTypeObject MiniMaxPlayerType;
 
 #endif /* MINIMAX_PLAYER_H */
@@ -4,15 +4,86 @@
 #include "random_player.h"
 #include "human_player.h"
 #include "minimax_player.h"
+#include "batch.h"
+#include "search_handle.h"
+#include "evaluate.h"
+#include "shared_table.h"
 #include <stdlib.h>
 #include <time.h>
 
+static PyObject* players_seed(PyObject* self, PyObject* args) {
+    unsigned int seed;
+    if (!PyArg_ParseTuple(args, "I", &seed)) {
+        return NULL;
+    }
+    seed_random_evaluate(seed);
+    Py_RETURN_NONE;
+}
+
+static PyObject* shared_table_error(OthelloStatus status, const char* error) {
+    PyErr_SetString(status == OTHELLO_ERROR_IO ? PyExc_OSError : PyExc_ValueError, error);
+    return NULL;
+}
+
+static PyObject* players_create_shared_table(PyObject* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"name", "size_mb", NULL};
+    const char* name;
+    Py_ssize_t size_mb = 64;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|n", kwlist, &name, &size_mb)) {
+        return NULL;
+    }
+    if (size_mb < 1) {
+        PyErr_SetString(PyExc_ValueError, "size_mb must be at least 1.");
+        return NULL;
+    }
+
+    char error[256];
+    OthelloStatus status = shared_table_create(name, (size_t)size_mb, error, sizeof(error));
+    if (status != OTHELLO_OK) {
+        return shared_table_error(status, error);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* players_destroy_shared_table(PyObject* self, PyObject* args) {
+    const char* name;
+    if (!PyArg_ParseTuple(args, "s", &name)) {
+        return NULL;
+    }
+
+    char error[256];
+    OthelloStatus status = shared_table_destroy(name, error, sizeof(error));
+    if (status != OTHELLO_OK) {
+        return shared_table_error(status, error);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef players_methods[] = {
+    {"seed", (PyCFunction)players_seed, METH_VARARGS,
+     "seed(n)\n"
+     "Makes RandomPlayer and random_evaluate repeatable. RandomPlayer() reseeds from the clock, so create players first."},
+    {"evaluate_batch", (PyCFunction)players_evaluate_batch, METH_VARARGS | METH_KEYWORDS,
+     "evaluate_batch(strategy, player_boards, opponent_boards, out, threads=0)\n"
+     "Scores every position with the named evaluator, writing int32 results into out."},
+    {"search_batch", (PyCFunction)players_search_batch, METH_VARARGS | METH_KEYWORDS,
+     "search_batch(strategy, depth, player_boards, opponent_boards, scores, moves=None, abp=True, threads=0)\n"
+     "Runs a fixed-depth search on every position, writing the best score and move (-1 on pass)."},
+    {"create_shared_table", (PyCFunction)players_create_shared_table, METH_VARARGS | METH_KEYWORDS,
+     "create_shared_table(name, size_mb=64)\n"
+     "Creates a transposition table in POSIX shared memory for MiniMaxPlayer(shared_table=name) in any process."},
+    {"destroy_shared_table", (PyCFunction)players_destroy_shared_table, METH_VARARGS,
+     "destroy_shared_table(name)\n"
+     "Removes the table; players already attached keep using it until they are freed."},
+    {NULL, NULL, 0, NULL}
+};
+
 static struct PyModuleDef players_module = {
     PyModuleDef_HEAD_INIT,
     "players",
     "C extension module for Othello Players",
     -1,
-    NULL, NULL, NULL, NULL, NULL
+    players_methods, NULL, NULL, NULL, NULL
 };
 
 PyMODINIT_FUNC PyInit_players(void) {
@@ -29,6 +100,9 @@ PyMODINIT_FUNC PyInit_players(void) {
     if (PyType_Ready(&MiniMaxPlayerType) < 0)
         return NULL;
 
+    if (PyType_Ready(&SearchHandleType) < 0)
+        return NULL;
+
     m = PyModule_Create(&players_module);
     if (m == NULL)
         return NULL;
@@ -54,5 +128,12 @@ PyMODINIT_FUNC PyInit_players(void) {
         return NULL;
     }
 
+    Py_INCREF(&SearchHandleType);
+    if (PyModule_AddObject(m, "SearchHandle", (PyObject*)&SearchHandleType) < 0) {
+        Py_DECREF(&SearchHandleType);
+        Py_DECREF(m);
+        return NULL;
+    }
+
     return m;
 }
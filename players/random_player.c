@@ -2,7 +2,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include "random_player.h"
-#include "othello.h"
+#include "board.h"
 
 static PyObject* RandomPlayer_init(PyObject* self, PyObject* args) {
     srand((unsigned int)time(NULL));
@@ -13,9 +13,12 @@ static PyObject* RandomPlayer_decide_move(PyObject* self, PyObject* args) {
     unsigned long long num_moves;
     unsigned long long player_board;
     unsigned long long opponent_board;
+    double time_left_ms = -1.0;
+    double increment_ms = 0.0;
 
-    if (!PyArg_ParseTuple(args, "KKK", &num_moves, &player_board, &opponent_board)) {
-        PyErr_SetString(PyExc_TypeError, "decide_move() arguments must be (num_moves, player_board, opponent_board).");
+    if (!PyArg_ParseTuple(args, "KKK|dd", &num_moves, &player_board, &opponent_board, &time_left_ms, &increment_ms)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "decide_move() arguments must be (num_moves, player_board, opponent_board[, time_left_ms, increment_ms]).");
         return NULL;
     }
 
@@ -0,0 +1,211 @@
+// players/search_handle.c
+
+#include "search_handle.h"
+#include "parallel.h"
+
+typedef struct {
+    PyObject_HEAD
+    MiniMaxPlayer* player;
+    PyObject* future;
+    ParallelThread thread;
+    uint64_t player_board;
+    uint64_t opponent_board;
+    int time_ms;
+    // Written by the search thread before it sets finished.
+    int best_move;
+    int score;
+    int depth;
+    uint64_t nodes;
+    // Read and written with the GIL held. Once set the thread no longer
+    // touches the handle.
+    bool finished;
+} SearchHandle;
+
+static void search_handle_run(void* arg) {
+    SearchHandle* self = (SearchHandle*)arg;
+    SearchContext* search = &self->player->search;
+
+    RootMoveList root_moves;
+    int time_limit_ms = search->time_limit_ms;
+    search->time_limit_ms = self->time_ms;
+    self->score = search_iterative(search, self->player_board, self->opponent_board, &root_moves);
+    search->time_limit_ms = time_limit_ms;
+    self->best_move = root_moves.best_index >= 0 ? root_moves.moves[root_moves.best_index].move : -1;
+    self->depth = root_moves.depth;
+    self->nodes = search->iter;
+
+    PyGILState_STATE gil = PyGILState_Ensure();
+    self->player->searching = false;
+    self->finished = true;
+
+    // Callbacks run here and may drop the last reference to the handle.
+    PyObject* future = self->future;
+    Py_INCREF(future);
+    PyObject* done = self->best_move >= 0 ? PyObject_CallMethod(future, "set_result", "i", self->best_move)
+                                          : PyObject_CallMethod(future, "set_result", "O", Py_None);
+    if (done == NULL) {
+        PyErr_WriteUnraisable(future);
+    }
+    Py_XDECREF(done);
+    Py_DECREF(future);
+    PyGILState_Release(gil);
+}
+
+PyObject* search_handle_start(MiniMaxPlayer* player, uint64_t player_board, uint64_t opponent_board, int time_ms) {
+    PyObject* futures = PyImport_ImportModule("concurrent.futures");
+    if (futures == NULL) {
+        return NULL;
+    }
+    PyObject* future = PyObject_CallMethod(futures, "Future", NULL);
+    Py_DECREF(futures);
+    if (future == NULL) {
+        return NULL;
+    }
+    // A running future can no longer be cancelled; stop() is the way to end it.
+    PyObject* running = PyObject_CallMethod(future, "set_running_or_notify_cancel", NULL);
+    if (running == NULL) {
+        Py_DECREF(future);
+        return NULL;
+    }
+    Py_DECREF(running);
+
+    SearchHandle* self = (SearchHandle*)SearchHandleType.tp_alloc(&SearchHandleType, 0);
+    if (self == NULL) {
+        Py_DECREF(future);
+        return NULL;
+    }
+    self->future = future;
+    self->player_board = player_board;
+    self->opponent_board = opponent_board;
+    self->time_ms = time_ms;
+
+    if (!minimax_player_claim(player)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    Py_INCREF(player);
+    self->player = player;
+    player->search.iter = 0;
+    player->search.stop_requested = 0;
+
+    if (parallel_thread_start(&self->thread, search_handle_run, self) != 0) {
+        player->searching = false;
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_RuntimeError, "Cannot start a search thread.");
+        return NULL;
+    }
+    return (PyObject*)self;
+}
+
+static void SearchHandle_dealloc(SearchHandle* self) {
+    if (self->thread.started) {
+        if (self->finished) {
+            parallel_thread_detach(&self->thread);
+        } else {
+            // Dropping a running search stops it.
+            search_request_stop(&self->player->search);
+            Py_BEGIN_ALLOW_THREADS
+            parallel_thread_join(&self->thread);
+            Py_END_ALLOW_THREADS
+        }
+    }
+    Py_XDECREF(self->future);
+    Py_XDECREF(self->player);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* SearchHandle_done(SearchHandle* self, PyObject* Py_UNUSED(ignored)) {
+    return PyBool_FromLong(self->finished);
+}
+
+static PyObject* SearchHandle_result(SearchHandle* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"timeout", NULL};
+    PyObject* timeout = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &timeout)) {
+        return NULL;
+    }
+    return PyObject_CallMethod(self->future, "result", "O", timeout);
+}
+
+static PyObject* SearchHandle_stop(SearchHandle* self, PyObject* Py_UNUSED(ignored)) {
+    if (!self->finished) {
+        search_request_stop(&self->player->search);
+    }
+    return PyObject_CallMethod(self->future, "result", NULL);
+}
+
+static PyObject* SearchHandle_await(SearchHandle* self) {
+    PyObject* asyncio = PyImport_ImportModule("asyncio");
+    if (asyncio == NULL) {
+        return NULL;
+    }
+    PyObject* wrapped = PyObject_CallMethod(asyncio, "wrap_future", "O", self->future);
+    Py_DECREF(asyncio);
+    if (wrapped == NULL) {
+        return NULL;
+    }
+    PyObject* iterator = PyObject_CallMethod(wrapped, "__await__", NULL);
+    Py_DECREF(wrapped);
+    return iterator;
+}
+
+static PyObject* SearchHandle_get_future(SearchHandle* self, void* closure) {
+    Py_INCREF(self->future);
+    return self->future;
+}
+
+static PyObject* SearchHandle_get_score(SearchHandle* self, void* closure) {
+    if (!self->finished) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromLong(self->score);
+}
+
+static PyObject* SearchHandle_get_depth(SearchHandle* self, void* closure) {
+    if (!self->finished) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromLong(self->depth);
+}
+
+static PyObject* SearchHandle_get_nodes(SearchHandle* self, void* closure) {
+    if (!self->finished) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromUnsignedLongLong(self->nodes);
+}
+
+static PyMethodDef SearchHandle_methods[] = {
+    {"done", (PyCFunction)SearchHandle_done, METH_NOARGS,
+     "True once the search has finished."},
+    {"result", (PyCFunction)SearchHandle_result, METH_VARARGS | METH_KEYWORDS,
+     "result(timeout=None)\n"
+     "Waits for the best move (None for a pass); raises TimeoutError when timeout seconds pass first."},
+    {"stop", (PyCFunction)SearchHandle_stop, METH_NOARGS,
+     "Stops the search and returns the best move of the deepest finished iteration."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef SearchHandle_getset[] = {
+    {"future", (getter)SearchHandle_get_future, NULL, "concurrent.futures.Future resolved with the best move.", NULL},
+    {"score", (getter)SearchHandle_get_score, NULL, "Score of the best move, None while searching.", NULL},
+    {"depth", (getter)SearchHandle_get_depth, NULL, "Deepest finished iteration, None while searching.", NULL},
+    {"nodes", (getter)SearchHandle_get_nodes, NULL, "Nodes searched, None while searching.", NULL},
+    {NULL}
+};
+
+static PyAsyncMethods SearchHandle_async = {
+    .am_await = (unaryfunc)SearchHandle_await,
+};
+
+PyTypeObject SearchHandleType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "players.SearchHandle",
+    .tp_basicsize = sizeof(SearchHandle),
+    .tp_dealloc = (destructor)SearchHandle_dealloc,
+    .tp_as_async = &SearchHandle_async,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "A search running on its own thread, returned by MiniMaxPlayer.start_search(). Awaitable.",
+    .tp_methods = SearchHandle_methods,
+    .tp_getset = SearchHandle_getset,
+};
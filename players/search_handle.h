@@ -0,0 +1,15 @@
+// players/search_handle.h
+
+#ifndef SEARCH_HANDLE_H
+#define SEARCH_HANDLE_H
+
+#include "minimax_player.h"
+#include <Python.h>
+
+extern PyTypeObject SearchHandleType;
+
+// Runs an iterative search of the position on its own native thread and
+// returns a players.SearchHandle for it. time_ms of 0 searches to max_depth.
+PyObject* search_handle_start(MiniMaxPlayer* player, uint64_t player_board, uint64_t opponent_board, int time_ms);
+
+#endif /* SEARCH_HANDLE_H */
@@ -0,0 +1,99 @@
+import socket
+
+
+class ServerBusy(RuntimeError):
+    """The othello_server queue was full."""
+
+
+class RemotePlayer:
+    """A player whose moves are searched by an othello_server.
+
+    address is a Unix socket path or a (host, port) pair. depth and time_ms
+    override the server's defaults for every move; on a clock the remaining
+    time is spread evenly over the player's remaining moves instead, as
+    MiniMaxPlayer does. move_overhead_ms is kept back on every move for the
+    round trip and the server's queue, which the server's time does not count.
+    """
+
+    def __init__(self, address, depth=None, time_ms=None, move_overhead_ms=10.0):
+        if move_overhead_ms < 0:
+            raise ValueError("move_overhead_ms must not be negative.")
+        if isinstance(address, str):
+            self._socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        else:
+            self._socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self._socket.connect(address)
+        self._reader = self._socket.makefile("r")
+        self.depth = depth
+        self.time_ms = time_ms
+        self.move_overhead_ms = move_overhead_ms
+        self.nodes = 0
+        self.last_reply = None
+
+    def _request(self, line):
+        self._socket.sendall((line + "\n").encode())
+        reply = self._reader.readline().split()
+        if not reply:
+            raise ConnectionError("othello_server closed the connection.")
+        if reply[0] == "busy":
+            raise ServerBusy("othello_server is busy.")
+        if reply[0] == "error":
+            raise ValueError(" ".join(reply[1:]))
+        return reply
+
+    def search(self, player_board, opponent_board, depth=None, time_ms=None):
+        """Returns the server's reply as a dict: move (None for a pass), score,
+        depth, nodes, wait_ms and search_ms."""
+        line = f"go {player_board:x} {opponent_board:x}"
+        if depth is not None:
+            line += f" depth {depth}"
+        if time_ms is not None:
+            line += f" time {max(1, int(time_ms))}"
+        reply = self._request(line)
+        fields = dict(zip(reply[0::2], reply[1::2]))
+        square = fields["move"]
+        move = None if square == "pass" else (int(square[1]) - 1) * 8 + ord(square[0]) - ord("a")
+        return {
+            "move": move,
+            "score": int(fields["score"]),
+            "depth": int(fields["depth"]),
+            "nodes": int(fields["nodes"]),
+            "wait_ms": float(fields["wait_ms"]),
+            "search_ms": float(fields["search_ms"]),
+        }
+
+    def decide_move(self, num_moves, player_board, opponent_board, time_left_ms=None, increment_ms=0.0):
+        if num_moves == 0:
+            return None
+        time_ms = self.time_ms
+        if time_left_ms is not None:
+            # The same split as time_budget_init: the clock is charged the whole
+            # round trip before the increment is credited.
+            usable = max(0.0, time_left_ms - self.move_overhead_ms)
+            empties = 64 - bin(player_board | opponent_board).count("1")
+            moves_left = max(1, (empties + 1) // 2)
+            time_ms = usable / moves_left + increment_ms * 3 / 4
+            time_ms = min(time_ms, usable / 2 if moves_left > 1 else usable)
+        self.last_reply = self.search(player_board, opponent_board, self.depth, time_ms)
+        self.nodes = self.last_reply["nodes"]
+        return self.last_reply["move"]
+
+    def stats(self):
+        """Server-wide queue and latency metrics, times in milliseconds."""
+        reply = self._request("stats")
+        return {key: float(value) if "." in value else int(value) for key, value in zip(reply[1::2], reply[2::2])}
+
+    def close(self):
+        try:
+            self._socket.sendall(b"quit\n")
+        except OSError:
+            pass
+        self._reader.close()
+        self._socket.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
@@ -0,0 +1,124 @@
+import csv
+import os
+import time
+from collections import defaultdict
+
+
+GAME_FIELDS = [
+    "black", "white", "game", "depth", "seed", "clock", "winner", "lost_on_time",
+    "black_discs", "white_discs", "duration_s", "black_nodes", "white_nodes",
+]
+# A game is only the same game when it was played with the same settings.
+GAME_KEY_FIELDS = ("black", "white", "game", "depth", "seed", "clock")
+
+
+def clock_setting(clock):
+    """The clock column: "" untimed, else "BASE_MS+INCREMENT_MS"."""
+    return "" if not clock else f"{clock[0]:g}+{clock[1]:g}"
+
+
+class ResultsWriter:
+    """Appends one CSV row per finished game and flushes to disk every
+    flush_every rows or flush_interval seconds, whichever comes first.
+
+    Opening an existing file resumes it: rows cut off by a crash are dropped,
+    and completed() tells which games are already recorded.
+    """
+
+    def __init__(self, path, fields=GAME_FIELDS, key_fields=GAME_KEY_FIELDS,
+                 flush_every=50, flush_interval=5.0):
+        self.path = path
+        self.fields = list(fields)
+        self.key_fields = key_fields
+        self.flush_every = flush_every
+        self.flush_interval = flush_interval
+        self._completed = set()
+
+        resuming = os.path.exists(path) and os.path.getsize(path) > 0
+        if resuming:
+            self._recover()
+        self._file = open(path, "a", newline="")
+        self._writer = csv.DictWriter(self._file, fieldnames=self.fields)
+        if not resuming:
+            self._writer.writeheader()
+        self._pending = 0
+        self._last_flush = time.monotonic()
+
+    def _recover(self):
+        with open(self.path, "rb+") as f:
+            data = f.read()
+            # A crash mid-write leaves a partial last line; cut it off.
+            end = data.rfind(b"\n") + 1
+            if end < len(data):
+                f.truncate(end)
+
+        with open(self.path, newline="") as f:
+            reader = csv.DictReader(f)
+            if reader.fieldnames != self.fields:
+                raise ValueError(f"{self.path} has columns {reader.fieldnames}, expected {self.fields}.")
+            for row in reader:
+                self._completed.add(self.key(row))
+
+    def key(self, row):
+        return tuple(str(row[field]) for field in self.key_fields)
+
+    def completed(self):
+        return self._completed
+
+    def write(self, row):
+        self._writer.writerow(row)
+        self._completed.add(self.key(row))
+        self._pending += 1
+        if self._pending >= self.flush_every or time.monotonic() - self._last_flush >= self.flush_interval:
+            self.flush()
+
+    def flush(self):
+        self._file.flush()
+        os.fsync(self._file.fileno())
+        self._pending = 0
+        self._last_flush = time.monotonic()
+
+    def close(self):
+        self.flush()
+        self._file.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+
+def read_rows(path):
+    with open(path, newline="") as f:
+        return list(csv.DictReader(f))
+
+
+def summarize_games(rows):
+    """Win/tie rates per (black, white) pair from game rows."""
+    counts = defaultdict(lambda: {"Black Wins": 0, "White Wins": 0, "Ties": 0, "Time Losses": 0})
+    for row in rows:
+        pair = counts[(row["black"], row["white"])]
+        winner = int(row["winner"])
+        if winner == 1:
+            pair["Black Wins"] += 1
+        elif winner == -1:
+            pair["White Wins"] += 1
+        else:
+            pair["Ties"] += 1
+        if row["lost_on_time"]:
+            pair["Time Losses"] += 1
+
+    results = []
+    for (black_eval, white_eval), pair in counts.items():
+        total = pair["Black Wins"] + pair["White Wins"] + pair["Ties"]
+        results.append({
+            "Black Evaluation": black_eval,
+            "White Evaluation": white_eval,
+            "Games": total,
+            "Black Win Rate (%)": (pair["Black Wins"] / total) * 100,
+            "White Win Rate (%)": (pair["White Wins"] / total) * 100,
+            "Tie Rate (%)": (pair["Ties"] / total) * 100,
+            "Time Losses": pair["Time Losses"]
+        })
+    return results
@@ -1,14 +1,41 @@
 # setup.py
 
 from setuptools import setup, Extension
+import sys
 import sysconfig
 
 python_include_dir = sysconfig.get_path('include')
+# shm_open lives in librt before glibc 2.34.
+system_libraries = ['rt'] if sys.platform.startswith('linux') else []
+
+core_sources = [
+    'core/api.c',
+    'core/board.c',
+    'core/evaluate.c',
+    'core/search.c',
+    'core/nnue.c',
+    'core/parallel.c',
+    'core/probcut.c',
+    'core/endgame.c',
+    'core/timeman.c',
+    'core/board_sized.c',
+    'core/shared_table.c',
+    'core/eval_cache.c',
+    'core/large_alloc.c',
+]
+
+core_library = ('othello_core', {
+    'sources': core_sources,
+    'include_dirs': ['core'],
+    'macros': [('OTHELLO_STATIC', None)],
+})
 
 othello_module = Extension(
     'othello',
-    sources=['othello/othello.c'],
-    include_dirs=['othello', python_include_dir],
+    sources=['othello/othello.c', 'othello/batch_game.c', 'othello/move_stats.c'],
+    include_dirs=['othello', 'core', python_include_dir],
+    define_macros=[('OTHELLO_STATIC', None)],
+    libraries=['othello_core'] + system_libraries,
 )
 
 players_module = Extension(
@@ -18,14 +45,18 @@ players_module = Extension(
         'players/random_player.c',
         'players/human_player.c',
         'players/minimax_player.c',
-        'othello/othello.c'
+        'players/batch.c',
+        'players/search_handle.c',
     ],
-    include_dirs=['players', 'othello', python_include_dir],
+    include_dirs=['players', 'core', python_include_dir],
+    define_macros=[('OTHELLO_STATIC', None)],
+    libraries=['othello_core'] + system_libraries,
 )
 
 setup(
     name='othello_project',
     version='1.0',
     description='Othello Game and Players with C Extensions',
+    libraries=[core_library],
     ext_modules=[othello_module, players_module],
 )
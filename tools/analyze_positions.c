@@ -0,0 +1,289 @@
+// tools/analyze_positions.c
+//
+// Multi-PV analysis of a file of positions on all cores. Each input line holds
+// 64 squares (X/x/* black, O/o white, -/. empty, row by row from a1) followed
+// by the side to move (X or O); anything after that, and lines starting with
+// '#', are ignored. Output has one line per input position, in input order:
+//
+//   <line>\t<move> <score> <pv,...>\t<move> <score> <pv,...>...
+//
+// with the moves sorted best first. Results are written as soon as every
+// earlier position is done, and throughput is reported on stderr at the end.
+//
+//   analyze_positions [--evaluator NAME] [--depth D] [--threads T]
+//                     [--nnue-weights PATH] [--endgame-empties N] INPUT [OUTPUT]
+
+#include "othello_core.h"
+#include "parallel.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LINE_SIZE 512
+#define RESULT_SIZE (OTHELLO_MAX_MOVES * (OTHELLO_MAX_PV * 5 + 16) + 32)
+
+typedef struct {
+    OthelloPosition position;
+    int line_number;
+    bool valid;
+} InputPosition;
+
+typedef struct {
+    OthelloSearchOptions options;
+    InputPosition* positions;
+    long position_count;
+    char** results;
+    volatile long* done;
+    volatile long next;
+    volatile long flushed;
+    volatile long writer_busy;
+    volatile long failed;
+    FILE* output;
+} AnalysisJob;
+
+static bool parse_position(const char* line, OthelloPosition* position) {
+    uint64_t black = 0;
+    uint64_t white = 0;
+    int square = 0;
+
+    while (*line == ' ' || *line == '\t') {
+        line++;
+    }
+    for (; square < 64 && *line; line++, square++) {
+        char c = *line;
+        if (c == 'X' || c == 'x' || c == '*') {
+            black |= 1ULL << square;
+        } else if (c == 'O' || c == 'o') {
+            white |= 1ULL << square;
+        } else if (c != '-' && c != '.') {
+            return false;
+        }
+    }
+    if (square < 64) {
+        return false;
+    }
+
+    while (*line == ' ' || *line == '\t') {
+        line++;
+    }
+    if (*line == 'X' || *line == 'x' || *line == '*') {
+        position->player = black;
+        position->opponent = white;
+    } else if (*line == 'O' || *line == 'o') {
+        position->player = white;
+        position->opponent = black;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static int format_square(int move, char* out) {
+    if (move == OTHELLO_PASS) {
+        return sprintf(out, "pass");
+    }
+    return sprintf(out, "%c%c", 'a' + move % 8, '1' + move / 8);
+}
+
+static char* format_result(const InputPosition* input, const OthelloMoveAnalysis* moves, int count) {
+    char* text = (char*)malloc(RESULT_SIZE);
+    if (text == NULL) {
+        return NULL;
+    }
+
+    int length = sprintf(text, "%d", input->line_number);
+    if (!input->valid) {
+        sprintf(text + length, "\terror: unreadable position\n");
+        return text;
+    }
+    if (count == 0) {
+        sprintf(text + length, "\tpass\n");
+        return text;
+    }
+
+    for (int i = 0; i < count; i++) {
+        text[length++] = '\t';
+        length += format_square(moves[i].move, text + length);
+        length += sprintf(text + length, " %d ", moves[i].score);
+        for (int j = 0; j < moves[i].pv_length; j++) {
+            if (j > 0) {
+                text[length++] = ',';
+            }
+            length += format_square(moves[i].pv[j], text + length);
+        }
+    }
+    sprintf(text + length, "\n");
+    return text;
+}
+
+// Writes every finished result that has no unfinished position before it.
+// Only one thread writes at a time; a thread that finds the writer busy leaves
+// its result for the next flush.
+static void flush_results(AnalysisJob* job) {
+    if (parallel_fetch_add(&job->writer_busy, 1) == 0) {
+        while (job->flushed < job->position_count && parallel_fetch_add(&job->done[job->flushed], 0)) {
+            char* text = job->results[job->flushed];
+            fputs(text ? text : "error: out of memory\n", job->output);
+            free(text);
+            job->results[job->flushed] = NULL;
+            job->flushed++;
+        }
+        fflush(job->output);
+    }
+    parallel_fetch_add(&job->writer_busy, -1);
+}
+
+static void analysis_worker(void* ctx, int thread_index, int thread_count) {
+    AnalysisJob* job = (AnalysisJob*)ctx;
+    (void)thread_index;
+    (void)thread_count;
+
+    OthelloStatus status;
+    OthelloEngine* engine = othello_engine_create(&job->options, &status);
+    if (engine == NULL) {
+        fprintf(stderr, "%s\n", othello_status_string(status));
+        parallel_fetch_add(&job->failed, 1);
+        return;
+    }
+
+    OthelloMoveAnalysis moves[OTHELLO_MAX_MOVES];
+    for (;;) {
+        long i = parallel_fetch_add(&job->next, 1);
+        if (i >= job->position_count) {
+            break;
+        }
+
+        int count = 0;
+        if (job->positions[i].valid) {
+            othello_engine_analyze(engine, &job->positions[i].position, moves, &count);
+        }
+        job->results[i] = format_result(&job->positions[i], moves, count);
+        parallel_fetch_add(&job->done[i], 1);
+        flush_results(job);
+    }
+
+    othello_engine_destroy(engine);
+}
+
+static long read_positions(FILE* input, InputPosition** positions) {
+    long capacity = 1024;
+    long count = 0;
+    int line_number = 0;
+    char line[LINE_SIZE];
+
+    *positions = (InputPosition*)malloc(sizeof(InputPosition) * capacity);
+    if (*positions == NULL) {
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), input) != NULL) {
+        line_number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[strspn(line, " \t")] == '\0') {
+            continue;
+        }
+
+        if (count == capacity) {
+            capacity *= 2;
+            InputPosition* grown = (InputPosition*)realloc(*positions, sizeof(InputPosition) * capacity);
+            if (grown == NULL) {
+                return -1;
+            }
+            *positions = grown;
+        }
+
+        InputPosition* position = &(*positions)[count++];
+        position->line_number = line_number;
+        position->valid = parse_position(line, &position->position);
+    }
+
+    return count;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: analyze_positions [--evaluator NAME] [--depth D] [--threads T] "
+                    "[--nnue-weights PATH] [--endgame-empties N] INPUT [OUTPUT]\n");
+}
+
+int main(int argc, char** argv) {
+    AnalysisJob job;
+    memset(&job, 0, sizeof(job));
+    othello_search_options_init(&job.options);
+    job.options.max_depth = 6;
+
+    int threads = 0;
+    const char* input_path = NULL;
+    const char* output_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--evaluator") == 0 && value) {
+            job.options.evaluator = value;
+        } else if (strcmp(argv[i], "--depth") == 0 && value) {
+            job.options.max_depth = atoi(value);
+        } else if (strcmp(argv[i], "--threads") == 0 && value) {
+            threads = atoi(value);
+        } else if (strcmp(argv[i], "--nnue-weights") == 0 && value) {
+            job.options.nnue_weights = value;
+        } else if (strcmp(argv[i], "--endgame-empties") == 0 && value) {
+            job.options.endgame_empties = atoi(value);
+        } else if (argv[i][0] != '-' && input_path == NULL) {
+            input_path = argv[i];
+            continue;
+        } else if (argv[i][0] != '-' && output_path == NULL) {
+            output_path = argv[i];
+            continue;
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    if (input_path == NULL || job.options.max_depth < 1 || job.options.max_depth > OTHELLO_MAX_PV) {
+        usage();
+        return 2;
+    }
+
+    FILE* input = fopen(input_path, "r");
+    if (input == NULL) {
+        fprintf(stderr, "Cannot open '%s'.\n", input_path);
+        return 1;
+    }
+    job.position_count = read_positions(input, &job.positions);
+    fclose(input);
+    if (job.position_count < 0) {
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+
+    job.output = output_path ? fopen(output_path, "w") : stdout;
+    if (job.output == NULL) {
+        fprintf(stderr, "Cannot write '%s'.\n", output_path);
+        return 1;
+    }
+
+    job.results = (char**)calloc(job.position_count + 1, sizeof(char*));
+    job.done = (volatile long*)calloc(job.position_count + 1, sizeof(long));
+    if (job.results == NULL || job.done == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+
+    uint64_t start = monotonic_ns();
+    run_parallel(threads > 0 ? threads : default_thread_count(), analysis_worker, &job);
+    flush_results(&job);
+    double seconds = (monotonic_ns() - start) / 1e9;
+
+    if (job.output != stdout) {
+        fclose(job.output);
+    }
+    fprintf(stderr, "%ld positions in %.2f s at depth %d: %.1f positions/s\n", job.position_count, seconds,
+            job.options.max_depth, seconds > 0 ? job.position_count / seconds : 0.0);
+
+    free(job.positions);
+    free(job.results);
+    free((void*)job.done);
+    return job.failed ? 1 : 0;
+}
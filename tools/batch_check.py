@@ -0,0 +1,75 @@
+"""Checks players.search_batch against MiniMaxPlayer.analyze.
+
+Positions from random games are searched in one batch on several threads, and
+each score must equal the best score analyze finds at the same depth. Exits 1
+on any difference and 77 (skipped under ctest) when the extensions have not
+been built with setup.py.
+
+    python3 tools/batch_check.py [--positions N] [--depth D] [--evaluator NAME] [--seed S]
+"""
+import argparse
+import array
+import os
+import random
+import sys
+
+# The extensions are built in place in the repository root.
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+try:
+    import othello
+    import players
+except ImportError as error:
+    print(f"Skipped: {error}; build the extensions with setup.py first.")
+    sys.exit(77)
+
+
+def random_positions(count, rng):
+    player = players.MiniMaxPlayer(max_depth=1)
+    positions = []
+    while len(positions) < count:
+        game = othello.OthelloGame(player, player)
+        for _ in range(rng.randrange(4, 40)):
+            moves = game.legal_moves()
+            if not moves:
+                break
+            game.push(rng.choice(moves))
+        if game.legal_moves():
+            if game.black_to_move:
+                positions.append((game.black_board, game.white_board))
+            else:
+                positions.append((game.white_board, game.black_board))
+    return positions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--positions", type=int, default=40)
+    parser.add_argument("--depth", type=int, default=3)
+    parser.add_argument("--evaluator", default="combined_evaluate")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    positions = random_positions(args.positions, random.Random(args.seed))
+    player_boards = array.array("Q", (p for p, _ in positions))
+    opponent_boards = array.array("Q", (o for _, o in positions))
+    scores = array.array("i", [0] * len(positions))
+    moves = array.array("i", [0] * len(positions))
+    players.search_batch(args.evaluator, args.depth, player_boards, opponent_boards, scores, moves, threads=4)
+
+    reference = players.MiniMaxPlayer(max_depth=args.depth, evaluation_strategy=args.evaluator)
+    differences = 0
+    for i, (player_board, opponent_board) in enumerate(positions):
+        analysis = reference.analyze(player_board, opponent_board)
+        best_score = analysis[0][1]
+        move_scores = {move: score for move, score, _ in analysis}
+        if scores[i] != best_score or move_scores.get(moves[i]) != best_score:
+            print(f"position {i} ({player_board:016x} {opponent_board:016x}): batch move {moves[i]} "
+                  f"score {scores[i]}, analyze move {analysis[0][0]} score {best_score}")
+            differences += 1
+
+    print(f"{len(positions)} positions at depth {args.depth}: {differences} differences")
+    return 1 if differences else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,201 @@
+// tools/ffo_bench.c
+//
+// Endgame solver benchmark and regression check on the FFO endgame test suite
+// (tools/ffo_endgames.txt). Every position is solved exactly and
+// single-threaded with the engine's endgame solver. Each one must reproduce
+// the known score and one of the known best moves, and must not take more
+// nodes than its recorded count plus --tolerance percent. The solver is
+// deterministic, so the node counts catch an ordering or pruning regression
+// on any machine. --max-seconds also bounds the total time. Prints one line
+// per position and the totals; the exit status is 1 on any failure.
+//
+//   ffo_bench [--first N] [--last N] [--tolerance PCT] [--max-seconds S] [FILE]
+//
+// FILE lines are "ID BOARD SIDE MOVES SCORE NODES". BOARD holds 64 squares of
+// X/O/- from a1 row by row, SIDE is X or O and MOVES lists the best moves,
+// comma separated. NODES is the recorded count, or - for none. Lines starting
+// with '#' are ignored.
+
+#include "board.h"
+#include "endgame.h"
+#include "search.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LINE_SIZE 256
+
+typedef struct {
+    int id;
+    uint64_t player_board;
+    uint64_t opponent_board;
+    char moves[64];
+    int score;
+    uint64_t nodes;
+} EndgamePosition;
+
+static bool parse_square(const char* name, int* square) {
+    if (name[0] >= 'a' && name[0] <= 'h' && name[1] >= '1' && name[1] <= '8') {
+        *square = (name[1] - '1') * 8 + name[0] - 'a';
+        return true;
+    }
+    return false;
+}
+
+static bool parse_line(const char* line, EndgamePosition* position) {
+    char board[65];
+    char side;
+    char nodes[32];
+    if (sscanf(line, "%d %64s %c %63s %d %31s", &position->id, board, &side, position->moves, &position->score,
+               nodes) != 6 || strlen(board) != 64 || (side != 'X' && side != 'O')) {
+        return false;
+    }
+
+    uint64_t black = 0;
+    uint64_t white = 0;
+    for (int square = 0; square < 64; square++) {
+        if (board[square] == 'X') {
+            black |= 1ULL << square;
+        } else if (board[square] == 'O') {
+            white |= 1ULL << square;
+        } else if (board[square] != '-') {
+            return false;
+        }
+    }
+    position->player_board = side == 'X' ? black : white;
+    position->opponent_board = side == 'X' ? white : black;
+    position->nodes = strcmp(nodes, "-") == 0 ? 0 : strtoull(nodes, NULL, 10);
+
+    for (const char* move = position->moves; *move; move += 2) {
+        int square;
+        if (!parse_square(move, &square)) {
+            return false;
+        }
+        if (move[2] == ',') {
+            move++;
+        }
+    }
+    return true;
+}
+
+static bool is_best_move(const EndgamePosition* position, int square) {
+    for (const char* move = position->moves; *move; move += move[2] == ',' ? 3 : 2) {
+        int best;
+        if (parse_square(move, &best) && best == square) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: ffo_bench [--first N] [--last N] [--tolerance PCT] [--max-seconds S] [FILE]\n");
+}
+
+int main(int argc, char** argv) {
+    int first = 0;
+    int last = 1000;
+    double tolerance = 10.0;
+    double max_seconds = 0.0;
+    const char* path = "tools/ffo_endgames.txt";
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--first") == 0 && value) {
+            first = atoi(value);
+        } else if (strcmp(argv[i], "--last") == 0 && value) {
+            last = atoi(value);
+        } else if (strcmp(argv[i], "--tolerance") == 0 && value) {
+            tolerance = atof(value);
+        } else if (strcmp(argv[i], "--max-seconds") == 0 && value) {
+            max_seconds = atof(value);
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+            continue;
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot open '%s'.\n", path);
+        return 2;
+    }
+
+    OthelloSearchOptions options;
+    othello_search_options_init(&options);
+    SearchContext search;
+    char error[256];
+    if (search_context_init(&search, &options, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        fclose(file);
+        return 2;
+    }
+
+    char line[LINE_SIZE];
+    int line_number = 0;
+    int solved = 0;
+    int failures = 0;
+    uint64_t total_nodes = 0;
+    double total_seconds = 0.0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        EndgamePosition position;
+        if (!parse_line(line, &position)) {
+            fprintf(stderr, "%s:%d: malformed position.\n", path, line_number);
+            failures++;
+            continue;
+        }
+        if (position.id < first || position.id > last) {
+            continue;
+        }
+
+        int empties = 64 - popcount64(position.player_board | position.opponent_board);
+        search.iter = 0;
+        int best_move;
+        uint64_t start = monotonic_ns();
+        int score = endgame_solve_root(&search, position.player_board, position.opponent_board, &best_move);
+        double seconds = (monotonic_ns() - start) / 1e9;
+
+        char move_name[4] = "--";
+        if (best_move >= 0) {
+            sprintf(move_name, "%c%c", 'a' + best_move % 8, '1' + best_move / 8);
+        }
+        const char* verdict = "ok";
+        if (score != position.score) {
+            verdict = "WRONG SCORE";
+        } else if (!is_best_move(&position, best_move)) {
+            verdict = "WRONG MOVE";
+        } else if (position.nodes && search.iter > position.nodes + (uint64_t)(position.nodes * tolerance / 100.0)) {
+            verdict = "SLOWER";
+        }
+        if (strcmp(verdict, "ok") != 0) {
+            failures++;
+        }
+
+        printf("#%d %2d empties  %s %+3d (expected %s %+d)  %12llu nodes  %8.3f s  %6.2f Mnps  %s\n", position.id,
+               empties, move_name, score, position.moves, position.score, (unsigned long long)search.iter, seconds,
+               seconds > 0 ? search.iter / seconds / 1e6 : 0.0, verdict);
+        fflush(stdout);
+        solved++;
+        total_nodes += search.iter;
+        total_seconds += seconds;
+    }
+    fclose(file);
+    search_context_free(&search);
+
+    printf("%d positions, %d failed: %llu nodes in %.3f s, %.2f Mnps\n", solved, failures,
+           (unsigned long long)total_nodes, total_seconds, total_seconds > 0 ? total_nodes / total_seconds / 1e6 : 0.0);
+    if (max_seconds > 0 && total_seconds > max_seconds) {
+        printf("Slower than --max-seconds %g.\n", max_seconds);
+        failures++;
+    }
+    return failures > 0 || solved == 0 ? 1 : 0;
+}
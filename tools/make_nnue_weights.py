@@ -0,0 +1,69 @@
+"""Writes a starting NNUE weight file for MiniMaxPlayer(evaluation_strategy="nnue_evaluate").
+
+The network is seeded from the POSITION_VALUES table and disc counts so it plays
+sensibly before any training; trained weights use the same file layout.
+"""
+import argparse
+import struct
+
+FEATURES = 128
+HIDDEN = 64
+L2 = 32
+MAGIC = b"ONNUE001"
+
+POSITION_VALUES = [
+    [100, -50, 2, 2, 2, 2, -50, 100],
+    [-50, -100, 1, 1, 1, 1, -100, -50],
+    [2, 1, 0, 0, 0, 0, 1, 2],
+    [2, 1, 0, 0, 0, 0, 1, 2],
+    [2, 1, 0, 0, 0, 0, 1, 2],
+    [2, 1, 0, 0, 0, 0, 1, 2],
+    [-50, -100, 1, 1, 1, 1, -100, -50],
+    [100, -50, 2, 2, 2, 2, -50, 100],
+]
+
+
+def build_network():
+    feature_weights = [[0] * HIDDEN for _ in range(FEATURES)]
+    for sq in range(64):
+        value = POSITION_VALUES[sq // 8][sq % 8]
+        for h in range(HIDDEN):
+            # The first half of the units track position values, the second half disc counts.
+            weight = value // 8 if h < HIDDEN // 2 else 2
+            feature_weights[sq][h] = weight
+            feature_weights[64 + sq][h] = -weight
+
+    feature_bias = [64] * HIDDEN
+    l2_weights = [[1] * HIDDEN + [-1] * HIDDEN for _ in range(L2)]
+    l2_bias = [64 << 6] * L2
+    output_weights = [1] * L2
+    output_bias = -64 * L2
+    return feature_weights, feature_bias, l2_weights, l2_bias, output_weights, output_bias
+
+
+def write_network(path, network):
+    feature_weights, feature_bias, l2_weights, l2_bias, output_weights, output_bias = network
+    with open(path, "wb") as f:
+        f.write(MAGIC)
+        f.write(struct.pack("<3i", FEATURES, HIDDEN, L2))
+        for row in feature_weights:
+            f.write(struct.pack(f"<{HIDDEN}h", *row))
+        f.write(struct.pack(f"<{HIDDEN}h", *feature_bias))
+        for row in l2_weights:
+            f.write(struct.pack(f"<{2 * HIDDEN}b", *row))
+        f.write(struct.pack(f"<{L2}i", *l2_bias))
+        f.write(struct.pack(f"<{L2}b", *output_weights))
+        f.write(struct.pack("<i", output_bias))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write a starting NNUE weight file.")
+    parser.add_argument("output", help="Path of the weight file to write.")
+    args = parser.parse_args()
+
+    write_network(args.output, build_network())
+    print(f"NNUE weights saved to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
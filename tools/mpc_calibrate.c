@@ -0,0 +1,261 @@
+// tools/mpc_calibrate.c
+//
+// Fits the Multi-ProbCut parameters used by MiniMaxPlayer(mpc_params=...).
+// Positions come from self-play with the chosen evaluator (random openings,
+// then shallow searches with occasional random moves). Every position is
+// searched at each depth up to --depth, and for each phase and depth d the
+// depth-d scores are regressed on the scores of the probe depth.
+//
+//   mpc_calibrate [--evaluator NAME] [--positions N] [--depth D] [--threads T]
+//                 [--seed S] [--nnue-weights PATH] OUTPUT
+
+#include "board.h"
+#include "search.h"
+#include "parallel.h"
+#include "probcut.h"
+#include "timer.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RANDOM_OPENING_PLIES 8
+#define RANDOM_MOVE_PERCENT 20
+#define SELF_PLAY_DEPTH 2
+#define MIN_SAMPLES 30
+// Scores this large come from decided games and would swamp the regression.
+#define MAX_FIT_SCORE 1000000
+
+typedef struct {
+    OthelloSearchOptions options;
+    OthelloPosition* positions;
+    int position_count;
+    int depth;
+    int* scores;
+    volatile long next;
+    volatile long failed;
+} CalibrationJob;
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static int random_move(uint64_t moves, uint64_t* rng) {
+    int skip = (int)(next_random(rng) % (uint64_t)popcount64(moves));
+    while (skip-- > 0) {
+        moves &= moves - 1;
+    }
+    return popcount64((moves & (~moves + 1)) - 1);
+}
+
+static int generate_positions(const OthelloSearchOptions* options, OthelloPosition* positions, int count, uint64_t seed) {
+    OthelloSearchOptions play_options = *options;
+    play_options.max_depth = SELF_PLAY_DEPTH;
+
+    SearchContext search;
+    char error[256];
+    if (search_context_init(&search, &play_options, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        return -1;
+    }
+
+    uint64_t rng = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    int generated = 0;
+    while (generated < count) {
+        OthelloPosition position = othello_initial_position();
+        for (int ply = 0; generated < count && !othello_is_game_over(&position); ply++) {
+            uint64_t moves = othello_legal_moves(&position);
+            if (moves == 0) {
+                othello_make_move(&position, OTHELLO_PASS);
+                continue;
+            }
+            if (ply >= RANDOM_OPENING_PLIES) {
+                positions[generated++] = position;
+            }
+
+            int move;
+            if (ply < RANDOM_OPENING_PLIES || next_random(&rng) % 100 < RANDOM_MOVE_PERCENT) {
+                move = random_move(moves, &rng);
+            } else {
+                search_root(&search, position.player, position.opponent, &move);
+            }
+            othello_make_move(&position, move);
+        }
+    }
+
+    search_context_free(&search);
+    return 0;
+}
+
+static void calibration_worker(void* ctx, int thread_index, int thread_count) {
+    CalibrationJob* job = (CalibrationJob*)ctx;
+    (void)thread_index;
+    (void)thread_count;
+
+    SearchContext search;
+    char error[256];
+    if (search_context_init(&search, &job->options, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        parallel_fetch_add(&job->failed, 1);
+        return;
+    }
+
+    for (;;) {
+        long i = parallel_fetch_add(&job->next, 1);
+        if (i >= job->position_count) {
+            break;
+        }
+
+        const OthelloPosition* position = &job->positions[i];
+        // Alternate node types so both max and min nodes are represented.
+        bool maximizing = (i & 1) == 0;
+        for (int depth = 1; depth <= job->depth; depth++) {
+            search.max_depth = depth;
+            if (search.nnue) {
+                nnue_refresh(search.nnue, &search.nnue_stack[0], position->player, position->opponent);
+            }
+            job->scores[i * (job->depth + 1) + depth] =
+                search.search->minimax_abp(position->player, position->opponent, depth, INT_MIN, INT_MAX, maximizing, &search);
+        }
+    }
+
+    search_context_free(&search);
+}
+
+static void fit_params(const CalibrationJob* job, MpcTable* table) {
+    for (int phase = 0; phase < MPC_PHASES; phase++) {
+        for (int depth = MPC_MIN_DEPTH; depth <= job->depth; depth++) {
+            int shallow = mpc_shallow_depth(depth);
+            double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, syy = 0.0;
+
+            for (int i = 0; i < job->position_count; i++) {
+                const OthelloPosition* position = &job->positions[i];
+                if (mpc_phase(position->player, position->opponent) != phase) {
+                    continue;
+                }
+                const int* scores = &job->scores[i * (job->depth + 1)];
+                double x = scores[shallow];
+                double y = scores[depth];
+                if (fabs(x) >= MAX_FIT_SCORE || fabs(y) >= MAX_FIT_SCORE) {
+                    continue;
+                }
+                n += 1.0;
+                sx += x;
+                sy += y;
+                sxx += x * x;
+                sxy += x * y;
+                syy += y * y;
+            }
+
+            MpcParams* params = &table->params[phase][depth];
+            params->samples = (int)n;
+            double variance_x = n * sxx - sx * sx;
+            if (n < MIN_SAMPLES || variance_x <= 0.0) {
+                continue;
+            }
+
+            params->a = (n * sxy - sx * sy) / variance_x;
+            params->b = (sy - params->a * sx) / n;
+            // Residual sum of squares of y - (a * x + b), expanded over the sums.
+            double residual = syy - 2.0 * params->a * sxy - 2.0 * params->b * sy + params->a * params->a * sxx +
+                              2.0 * params->a * params->b * sx + n * params->b * params->b;
+            params->sigma = sqrt(residual > 0.0 ? residual / (n - 2.0) : 0.0);
+        }
+    }
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: mpc_calibrate [--evaluator NAME] [--positions N] [--depth D] [--threads T] "
+                    "[--seed S] [--nnue-weights PATH] OUTPUT\n");
+}
+
+int main(int argc, char** argv) {
+    CalibrationJob job;
+    memset(&job, 0, sizeof(job));
+    othello_search_options_init(&job.options);
+    job.position_count = 2000;
+    job.depth = 8;
+
+    int threads = 0;
+    uint64_t seed = 1;
+    const char* output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--evaluator") == 0 && value) {
+            job.options.evaluator = value;
+        } else if (strcmp(argv[i], "--positions") == 0 && value) {
+            job.position_count = atoi(value);
+        } else if (strcmp(argv[i], "--depth") == 0 && value) {
+            job.depth = atoi(value);
+        } else if (strcmp(argv[i], "--threads") == 0 && value) {
+            threads = atoi(value);
+        } else if (strcmp(argv[i], "--seed") == 0 && value) {
+            seed = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "--nnue-weights") == 0 && value) {
+            job.options.nnue_weights = value;
+        } else if (argv[i][0] != '-' && output == NULL) {
+            output = argv[i];
+            continue;
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    if (output == NULL || job.position_count < 1 || job.depth < MPC_MIN_DEPTH || job.depth > MPC_MAX_DEPTH) {
+        usage();
+        return 2;
+    }
+    job.options.max_depth = job.depth;
+
+    job.positions = (OthelloPosition*)malloc(sizeof(OthelloPosition) * job.position_count);
+    job.scores = (int*)malloc(sizeof(int) * job.position_count * (job.depth + 1));
+    if (job.positions == NULL || job.scores == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+
+    uint64_t start = monotonic_ns();
+    if (generate_positions(&job.options, job.positions, job.position_count, seed) < 0) {
+        return 1;
+    }
+
+    run_parallel(threads > 0 ? threads : default_thread_count(), calibration_worker, &job);
+    if (job.failed) {
+        return 1;
+    }
+
+    MpcTable table;
+    memset(&table, 0, sizeof(table));
+    snprintf(table.evaluator, sizeof(table.evaluator), "%s", job.options.evaluator);
+    fit_params(&job, &table);
+
+    if (!mpc_save(&table, output)) {
+        fprintf(stderr, "Cannot write '%s'.\n", output);
+        return 1;
+    }
+
+    printf("%d positions, depths %d-%d, %.1f s\n", job.position_count, MPC_MIN_DEPTH, job.depth,
+           (monotonic_ns() - start) / 1e9);
+    for (int phase = 0; phase < MPC_PHASES; phase++) {
+        for (int depth = MPC_MIN_DEPTH; depth <= job.depth; depth++) {
+            const MpcParams* params = &table.params[phase][depth];
+            if (params->sigma > 0.0) {
+                printf("phase %d depth %2d <- %d: a=%.3f b=%.1f sigma=%.1f (%d)\n", phase, depth,
+                       mpc_shallow_depth(depth), params->a, params->b, params->sigma, params->samples);
+            }
+        }
+    }
+
+    free(job.positions);
+    free(job.scores);
+    return 0;
+}
@@ -0,0 +1,154 @@
+// tools/probe_bench.c
+//
+// Probe latency of a large leaf evaluation cache with normal pages, with huge
+// pages (explicit when a pool is reserved, else transparent) and, on machines
+// with several NUMA nodes, with huge pages interleaved over the nodes. The
+// table is first written by the main thread, then every thread runs a chain of
+// dependent probes at random slots, so each probe waits for the one before
+// it as the search's TLB and cache misses do. Prints one line per mode:
+//
+//   <mode> <pages granted> interleaved=<0|1> anon_huge_mb=<M> <ns per probe>
+//
+//   probe_bench [--size MB] [--probes N] [--threads T]
+
+#include "eval_cache.h"
+#include "large_alloc.h"
+#include "parallel.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    EvalCache cache;
+    long probes;
+    volatile long hits;
+    double* thread_ns;
+} ProbeJob;
+
+static void probe_worker(void* ctx, int thread_index, int thread_count) {
+    ProbeJob* job = (ProbeJob*)ctx;
+    EvalCache cache = job->cache;
+    cache.hits = 0;
+    cache.misses = 0;
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL * (uint64_t)(thread_index + 1);
+    int score = 0;
+    uint64_t start = monotonic_ns();
+    for (long i = 0; i < job->probes; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t player_board = state + (uint64_t)score;
+        uint64_t opponent_board = ~player_board & (state >> 3);
+        EvalCacheEntry* entry = eval_cache_entry(&cache, player_board, opponent_board);
+        if (eval_cache_hit(&cache, entry, player_board, opponent_board)) {
+            score = entry->score;
+        } else {
+            score = (int)(state & 63);
+            eval_cache_fill(entry, player_board, opponent_board, score);
+        }
+    }
+    job->thread_ns[thread_index] = (double)(monotonic_ns() - start) / (double)job->probes;
+    parallel_fetch_add(&job->hits, (long)cache.hits);
+}
+
+// AnonHugePages of this process in MB, or -1 where the kernel does not say.
+static long anon_huge_mb(void) {
+    long kb = -1;
+    FILE* file = fopen("/proc/self/smaps_rollup", "r");
+    if (file == NULL) {
+        return -1;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+    return kb < 0 ? -1 : kb / 1024;
+}
+
+static int run_mode(const char* name, int flags, size_t size_mb, long probes, int threads) {
+    ProbeJob job;
+    memset(&job, 0, sizeof(job));
+    uint64_t entries = ((uint64_t)size_mb << 20) / sizeof(EvalCacheEntry);
+    while (entries & (entries - 1)) {
+        entries &= entries - 1;
+    }
+    if (!large_alloc(&job.cache.block, (size_t)entries * sizeof(EvalCacheEntry), flags)) {
+        fprintf(stderr, "%s: out of memory.\n", name);
+        return 1;
+    }
+    job.cache.entries = (EvalCacheEntry*)job.cache.block.memory;
+    job.cache.mask = entries - 1;
+    job.probes = probes;
+    job.thread_ns = (double*)calloc((size_t)threads, sizeof(double));
+    if (job.thread_ns == NULL) {
+        large_free(&job.cache.block);
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+
+    long huge_before = anon_huge_mb();
+    memset(job.cache.entries, 0, (size_t)entries * sizeof(EvalCacheEntry));
+    long huge_after = anon_huge_mb();
+    run_parallel(threads, probe_worker, &job);
+
+    double ns = 0.0;
+    for (int i = 0; i < threads; i++) {
+        ns += job.thread_ns[i] / threads;
+    }
+    printf("%-16s %-12s interleaved=%d anon_huge_mb=%ld %.1f ns/probe\n", name,
+           large_pages_name(job.cache.block.pages), job.cache.block.interleaved ? 1 : 0,
+           huge_before < 0 ? -1 : huge_after - huge_before, ns);
+    fflush(stdout);
+
+    free(job.thread_ns);
+    large_free(&job.cache.block);
+    return 0;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: probe_bench [--size MB] [--probes N] [--threads T]\n");
+}
+
+int main(int argc, char** argv) {
+    long size_mb = 1024;
+    long probes = 20000000;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--size") == 0 && value) {
+            size_mb = atol(value);
+        } else if (strcmp(argv[i], "--probes") == 0 && value) {
+            probes = atol(value);
+        } else if (strcmp(argv[i], "--threads") == 0 && value) {
+            threads = atoi(value);
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+    if (size_mb < 1 || probes < 1) {
+        usage();
+        return 2;
+    }
+    if (threads <= 0) {
+        threads = default_thread_count();
+    }
+
+    int nodes = large_alloc_node_count();
+    printf("%ld MB table, %ld probes per thread, %d threads, %d NUMA node%s\n", size_mb, probes, threads, nodes,
+           nodes == 1 ? "" : "s");
+    int failed = run_mode("normal", 0, (size_t)size_mb, probes, threads);
+    failed |= run_mode("huge", LARGE_ALLOC_HUGE_PAGES, (size_t)size_mb, probes, threads);
+    if (nodes > 1) {
+        failed |= run_mode("huge+interleave", LARGE_ALLOC_HUGE_PAGES | LARGE_ALLOC_INTERLEAVE, (size_t)size_mb,
+                           probes, threads);
+    }
+    return failed;
+}
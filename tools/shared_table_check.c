@@ -0,0 +1,132 @@
+// tools/shared_table_check.c
+//
+// Checks that a warmed shared transposition table never changes a search's
+// result. Positions from random games are searched at depth D + 1 into a
+// fresh table, then at depth D both with that table and without one. Every
+// entry the deeper search left is one ply deeper than the position's depth in
+// the shallower search, so none may decide a node there. Both depth-D searches
+// must agree on every score and best move. Exits 1 on the first difference.
+//
+//   shared_table_check [--positions N] [--depth D] [--evaluator NAME] [--seed S]
+
+#include "board.h"
+#include "search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static bool random_position(uint64_t* rng, OthelloPosition* position) {
+    *position = othello_initial_position();
+    int plies = 8 + (int)(next_random(rng) % 30);
+    for (int ply = 0; ply < plies; ply++) {
+        if (othello_is_game_over(position)) {
+            return false;
+        }
+        uint64_t moves = othello_legal_moves(position);
+        if (moves == 0) {
+            othello_make_move(position, OTHELLO_PASS);
+            continue;
+        }
+        int skip = (int)(next_random(rng) % (uint64_t)popcount64(moves));
+        while (skip-- > 0) {
+            moves &= moves - 1;
+        }
+        othello_make_move(position, popcount64((moves & (~moves + 1)) - 1));
+    }
+    return !othello_is_game_over(position);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: shared_table_check [--positions N] [--depth D] [--evaluator NAME] [--seed S]\n");
+}
+
+int main(int argc, char** argv) {
+    int positions = 60;
+    int depth = 4;
+    const char* evaluator = "combined_evaluate";
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--positions") == 0 && value) {
+            positions = atoi(value);
+        } else if (strcmp(argv[i], "--depth") == 0 && value) {
+            depth = atoi(value);
+        } else if (strcmp(argv[i], "--evaluator") == 0 && value) {
+            evaluator = value;
+        } else if (strcmp(argv[i], "--seed") == 0 && value) {
+            rng = strtoull(value, NULL, 10) | 1;
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+    if (positions < 1 || depth < 1) {
+        usage();
+        return 2;
+    }
+
+    char name[64];
+    char error[256];
+    snprintf(name, sizeof(name), "/othello-check-%ld", (long)getpid());
+    if (shared_table_create(name, 16, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        return 2;
+    }
+
+    OthelloSearchOptions options;
+    othello_search_options_init(&options);
+    options.evaluator = evaluator;
+    options.max_depth = depth;
+    SearchContext plain;
+    SearchContext shallow;
+    SearchContext deep;
+    bool ready = search_context_init(&plain, &options, error, sizeof(error)) == OTHELLO_OK;
+    options.shared_table = name;
+    ready = ready && search_context_init(&shallow, &options, error, sizeof(error)) == OTHELLO_OK;
+    options.max_depth = depth + 1;
+    ready = ready && search_context_init(&deep, &options, error, sizeof(error)) == OTHELLO_OK;
+    if (!ready) {
+        fprintf(stderr, "%s\n", error);
+        shared_table_destroy(name, error, sizeof(error));
+        return 2;
+    }
+
+    int differences = 0;
+    for (int checked = 0; checked < positions;) {
+        OthelloPosition position;
+        if (!random_position(&rng, &position)) {
+            continue;
+        }
+        checked++;
+
+        int deep_move, table_move, plain_move;
+        search_root(&deep, position.player, position.opponent, &deep_move);
+        int table_score = search_root(&shallow, position.player, position.opponent, &table_move);
+        int plain_score = search_root(&plain, position.player, position.opponent, &plain_move);
+        if (table_score != plain_score || table_move != plain_move) {
+            printf("position %d (%016llx %016llx): with table move %d score %d, without move %d score %d\n", checked,
+                   (unsigned long long)position.player, (unsigned long long)position.opponent, table_move,
+                   table_score, plain_move, plain_score);
+            differences++;
+        }
+    }
+
+    search_context_free(&plain);
+    search_context_free(&shallow);
+    search_context_free(&deep);
+    shared_table_destroy(name, error, sizeof(error));
+    printf("%d positions at depth %d after depth %d: %d differences\n", positions, depth, depth + 1, differences);
+    return differences > 0 ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+// tools/solve_small.c
+//
+// Perfect-play solver and move-generator check for the generated board sizes.
+// Solves the initial position of a SIZE x SIZE board (or searches it to a
+// fixed depth) and prints the score, best move, nodes and speed; --perft
+// instead counts the leaves of the move tree to depth D, with a forced pass
+// counting as a move, for comparing move generators.
+//
+//   solve_small [--size 4|6|8|10] [--depth D] [--perft D] [--moves m1,m2,...]
+//
+// --moves plays the given squares (row * size + col, or "pass") first. Exact
+// solves are practical up to about 24 empties, so 6x6 and larger boards need
+// --moves or --depth.
+
+#include "othello_core.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t perft(const OthelloSizedPosition* position, int depth, bool passed) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    int moves[OTHELLO_MAX_BOARD_SIZE * OTHELLO_MAX_BOARD_SIZE];
+    int count = othello_sized_legal_moves(position, moves);
+    if (count == 0) {
+        if (passed) {
+            return 1;
+        }
+        OthelloSizedPosition next = *position;
+        othello_sized_make_move(&next, OTHELLO_PASS);
+        return perft(&next, depth - 1, true);
+    }
+
+    uint64_t leaves = 0;
+    for (int i = 0; i < count; i++) {
+        OthelloSizedPosition next = *position;
+        othello_sized_make_move(&next, moves[i]);
+        leaves += perft(&next, depth - 1, false);
+    }
+    return leaves;
+}
+
+static bool play_moves(OthelloSizedPosition* position, char* list) {
+    for (char* token = strtok(list, ","); token != NULL; token = strtok(NULL, ",")) {
+        int move = strcmp(token, "pass") == 0 ? OTHELLO_PASS : atoi(token);
+        if (othello_sized_make_move(position, move) != OTHELLO_OK) {
+            fprintf(stderr, "Illegal move '%s'.\n", token);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: solve_small [--size 4|6|8|10] [--depth D] [--perft D] [--moves m1,m2,...]\n");
+}
+
+int main(int argc, char** argv) {
+    int size = 6;
+    int depth = 0;
+    int perft_depth = 0;
+    char* moves = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--size") == 0 && value) {
+            size = atoi(value);
+        } else if (strcmp(argv[i], "--depth") == 0 && value) {
+            depth = atoi(value);
+        } else if (strcmp(argv[i], "--perft") == 0 && value) {
+            perft_depth = atoi(value);
+        } else if (strcmp(argv[i], "--moves") == 0 && value) {
+            moves = argv[i + 1];
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    OthelloSizedPosition position;
+    if (othello_sized_initial_position(size, &position) != OTHELLO_OK) {
+        fprintf(stderr, "Board size %d is not supported by this build.\n", size);
+        return 2;
+    }
+    if (moves != NULL && !play_moves(&position, moves)) {
+        return 1;
+    }
+
+    uint64_t start = monotonic_ns();
+    if (perft_depth > 0) {
+        uint64_t leaves = perft(&position, perft_depth, false);
+        double seconds = (monotonic_ns() - start) / 1e9;
+        printf("perft %d on %dx%d: %llu leaves in %.3f s\n", perft_depth, size, size, (unsigned long long)leaves, seconds);
+        return 0;
+    }
+
+    OthelloSearchResult result;
+    OthelloStatus status = depth > 0 ? othello_sized_search(&position, depth, &result) : othello_sized_solve(&position, &result);
+    if (status != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", othello_status_string(status));
+        return 1;
+    }
+    double seconds = (monotonic_ns() - start) / 1e9;
+
+    printf("%dx%d %s %d: score %d, best move %d, %llu nodes in %.3f s (%.0f nodes/s)\n", size, size,
+           depth > 0 ? "depth" : "exact, empties", result.depth, result.score, result.best_move,
+           (unsigned long long)result.nodes, seconds, seconds > 0 ? result.nodes / seconds : 0.0);
+    return 0;
+}
@@ -0,0 +1,337 @@
+// tools/spsa_tune.c
+//
+// Tunes the parameters of a composed evaluator with SPSA: the two phase
+// limits, the material, mobility, positional, corner, edge, frontier and
+// parity weights of every phase, and the square values (one per square up to
+// the board's symmetry). Each iteration perturbs all parameters at once in a
+// random direction, plays a batch of fixed-depth games between the two
+// perturbed evaluators on all cores, and moves the parameters towards the
+// side that scored better. Every game pair starts from a random opening played
+// once with each color. The result is written after every iteration, so an
+// interrupted run keeps its progress, and loads with
+// MiniMaxPlayer(eval_params=...).
+//
+// Starts from combined_evaluate's parameters unless --start names a file.
+//
+//   spsa_tune [--iterations N] [--games G] [--depth D] [--threads T] [--seed S]
+//             [--learning-rate R] [--start PATH] [--verify G] OUTPUT
+
+#include "board.h"
+#include "evaluate.h"
+#include "search.h"
+#include "parallel.h"
+#include "timer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define OPENING_PLIES 8
+#define SQUARE_CLASSES 10
+#define TUNED_TERMS 7
+#define MAX_PARAMS (OTHELLO_EVAL_PHASES - 1 + OTHELLO_EVAL_PHASES * TUNED_TERMS + SQUARE_CLASSES)
+
+typedef struct {
+    double value;
+    // Perturbation size at the first iteration.
+    double step;
+    double min;
+    double max;
+} Param;
+
+typedef struct {
+    OthelloSearchOptions options;
+    ComposedEvaluator first;
+    ComposedEvaluator second;
+    long pairs;
+    uint64_t seed;
+    volatile long next;
+    // Points of first, in half points.
+    volatile long half_points;
+    volatile long failed;
+} MatchJob;
+
+static const EvalTerm TUNED[TUNED_TERMS] = {
+    EVAL_TERM_MATERIAL, EVAL_TERM_MOBILITY, EVAL_TERM_POSITIONAL, EVAL_TERM_CORNER,
+    EVAL_TERM_EDGE, EVAL_TERM_FRONTIER, EVAL_TERM_PARITY,
+};
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static int random_move(uint64_t moves, uint64_t* rng) {
+    int skip = (int)(next_random(rng) % (uint64_t)popcount64(moves));
+    while (skip-- > 0) {
+        moves &= moves - 1;
+    }
+    return popcount64((moves & (~moves + 1)) - 1);
+}
+
+// Squares that are equal up to the board's symmetry share a class: row and
+// column are folded into the top-left quarter and ordered.
+static int square_class(int square) {
+    int row = square / 8 < 4 ? square / 8 : 7 - square / 8;
+    int col = square % 8 < 4 ? square % 8 : 7 - square % 8;
+    if (row > col) {
+        int swap = row;
+        row = col;
+        col = swap;
+    }
+    static const int FIRST_OF_ROW[4] = {0, 4, 7, 9};
+    return FIRST_OF_ROW[row] + col - row;
+}
+
+static int params_from_evaluator(const ComposedEvaluator* composer, Param* params) {
+    int count = 0;
+    for (int i = 0; i < OTHELLO_EVAL_PHASES - 1; i++) {
+        params[count++] = (Param){composer->phase_limits[i], 2.0, 4.0, 64.0};
+    }
+    for (int phase = 0; phase < OTHELLO_EVAL_PHASES; phase++) {
+        for (int i = 0; i < TUNED_TERMS; i++) {
+            params[count++] = (Param){composer->weights[phase][TUNED[i]], 1.0, -100.0, 100.0};
+        }
+    }
+    // Each class starts from the value of its first square.
+    for (int square = 63; square >= 0; square--) {
+        params[count + square_class(square)] = (Param){composer->position_values[square], 3.0, -200.0, 200.0};
+    }
+    return count + SQUARE_CLASSES;
+}
+
+// Writes the rounded values into composer, whose other fields are kept.
+static void params_to_evaluator(const Param* params, const double* values, ComposedEvaluator* composer) {
+    int index = 0;
+    for (int i = 0; i < OTHELLO_EVAL_PHASES - 1; i++, index++) {
+        double value = values[index] < params[index].min ? params[index].min : values[index];
+        composer->phase_limits[i] = (int)lround(value > params[index].max ? params[index].max : value);
+    }
+    if (composer->phase_limits[1] < composer->phase_limits[0]) {
+        composer->phase_limits[1] = composer->phase_limits[0];
+    }
+    for (int phase = 0; phase < OTHELLO_EVAL_PHASES; phase++) {
+        for (int i = 0; i < TUNED_TERMS; i++, index++) {
+            composer->weights[phase][TUNED[i]] = (int)lround(values[index]);
+        }
+    }
+    for (int square = 0; square < 64; square++) {
+        composer->position_values[square] = (int)lround(values[index + square_class(square)]);
+    }
+}
+
+// Plays to the end with first to move from position; returns the final disc
+// difference for first.
+static int play_game(SearchContext* first, SearchContext* second, OthelloPosition position) {
+    bool first_to_move = true;
+    while (!othello_is_game_over(&position)) {
+        int move = OTHELLO_PASS;
+        if (othello_legal_moves(&position) != 0) {
+            search_root(first_to_move ? first : second, position.player, position.opponent, &move);
+        }
+        othello_make_move(&position, move);
+        first_to_move = !first_to_move;
+    }
+    int difference = popcount64(position.player) - popcount64(position.opponent);
+    return first_to_move ? difference : -difference;
+}
+
+static void match_worker(void* ctx, int thread_index, int thread_count) {
+    MatchJob* job = (MatchJob*)ctx;
+    (void)thread_index;
+    (void)thread_count;
+
+    SearchContext first;
+    SearchContext second;
+    char error[256];
+    if (search_context_init(&first, &job->options, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        parallel_fetch_add(&job->failed, 1);
+        return;
+    }
+    if (search_context_init(&second, &job->options, error, sizeof(error)) != OTHELLO_OK) {
+        fprintf(stderr, "%s\n", error);
+        search_context_free(&first);
+        parallel_fetch_add(&job->failed, 1);
+        return;
+    }
+    // The options only make room for a composer; the parameters come from the job.
+    *first.composer = job->first;
+    *second.composer = job->second;
+
+    for (;;) {
+        long pair = parallel_fetch_add(&job->next, 1);
+        if (pair >= job->pairs) {
+            break;
+        }
+
+        uint64_t rng = (job->seed + (uint64_t)pair) * 0x9E3779B97F4A7C15ULL | 1;
+        OthelloPosition opening = othello_initial_position();
+        for (int ply = 0; ply < OPENING_PLIES && !othello_is_game_over(&opening); ply++) {
+            uint64_t moves = othello_legal_moves(&opening);
+            othello_make_move(&opening, moves ? random_move(moves, &rng) : OTHELLO_PASS);
+        }
+
+        int half_points = 0;
+        int difference = play_game(&first, &second, opening);
+        half_points += difference > 0 ? 2 : (difference == 0 ? 1 : 0);
+        difference = play_game(&second, &first, opening);
+        half_points += difference < 0 ? 2 : (difference == 0 ? 1 : 0);
+        parallel_fetch_add(&job->half_points, half_points);
+    }
+
+    search_context_free(&first);
+    search_context_free(&second);
+}
+
+// Score of first against second in [0, 1], or -1 on failure.
+static double play_match(MatchJob* job, int threads) {
+    job->next = 0;
+    job->half_points = 0;
+    run_parallel(threads, match_worker, job);
+    if (job->failed) {
+        return -1.0;
+    }
+    return job->half_points / (4.0 * job->pairs);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: spsa_tune [--iterations N] [--games G] [--depth D] [--threads T] [--seed S] "
+                    "[--learning-rate R] [--start PATH] [--verify G] OUTPUT\n");
+}
+
+int main(int argc, char** argv) {
+    int iterations = 200;
+    long games = 256;
+    int depth = 2;
+    int threads = 0;
+    uint64_t seed = 1;
+    double learning_rate = 1.0;
+    long verify_games = 0;
+    const char* start = NULL;
+    const char* output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--iterations") == 0 && value) {
+            iterations = atoi(value);
+        } else if (strcmp(argv[i], "--games") == 0 && value) {
+            games = atol(value);
+        } else if (strcmp(argv[i], "--depth") == 0 && value) {
+            depth = atoi(value);
+        } else if (strcmp(argv[i], "--threads") == 0 && value) {
+            threads = atoi(value);
+        } else if (strcmp(argv[i], "--seed") == 0 && value) {
+            seed = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i], "--learning-rate") == 0 && value) {
+            learning_rate = atof(value);
+        } else if (strcmp(argv[i], "--start") == 0 && value) {
+            start = value;
+        } else if (strcmp(argv[i], "--verify") == 0 && value) {
+            verify_games = atol(value);
+        } else if (argv[i][0] != '-' && output == NULL) {
+            output = argv[i];
+            continue;
+        } else {
+            usage();
+            return 2;
+        }
+        i++;
+    }
+
+    if (output == NULL || iterations < 1 || games < 2 || depth < 1 || verify_games < 0 || learning_rate <= 0.0) {
+        usage();
+        return 2;
+    }
+    threads = threads > 0 ? threads : default_thread_count();
+
+    ComposedEvaluator initial;
+    if (start != NULL) {
+        char error[256];
+        if (composed_evaluator_load(&initial, start, error, sizeof(error)) != OTHELLO_OK) {
+            fprintf(stderr, "%s\n", error);
+            return 1;
+        }
+    } else {
+        combined_evaluator_params(&initial);
+    }
+
+    MatchJob job;
+    memset(&job, 0, sizeof(job));
+    static const OthelloEvalTerm PLACEHOLDER = {"material_evaluate", {0, 0, 0}};
+    othello_search_options_init(&job.options);
+    job.options.max_depth = depth;
+    job.options.eval_terms = &PLACEHOLDER;
+    job.options.eval_term_count = 1;
+    job.pairs = games / 2;
+
+    Param params[MAX_PARAMS];
+    int count = params_from_evaluator(&initial, params);
+    double values[MAX_PARAMS];
+    double plus[MAX_PARAMS];
+    double minus[MAX_PARAMS];
+    for (int i = 0; i < count; i++) {
+        values[i] = params[i].value;
+    }
+
+    // Standard SPSA gain sequences, scaled so the first iteration uses the
+    // nominal step and learning rate.
+    double stability = iterations * 0.1;
+    uint64_t rng = seed * 0xD1B54A32D192ED03ULL | 1;
+    ComposedEvaluator tuned = initial;
+    uint64_t start_ns = monotonic_ns();
+
+    for (int k = 0; k < iterations; k++) {
+        double step_gain = 1.0 / pow(k + 1.0, 0.101);
+        double rate = learning_rate * pow((1.0 + stability) / (k + 1.0 + stability), 0.602);
+
+        double direction[MAX_PARAMS];
+        for (int i = 0; i < count; i++) {
+            direction[i] = (next_random(&rng) & 1) ? 1.0 : -1.0;
+            plus[i] = values[i] + params[i].step * step_gain * direction[i];
+            minus[i] = values[i] - params[i].step * step_gain * direction[i];
+        }
+        job.first = initial;
+        job.second = initial;
+        params_to_evaluator(params, plus, &job.first);
+        params_to_evaluator(params, minus, &job.second);
+        job.seed = seed * 1000003ULL + (uint64_t)k * (uint64_t)job.pairs;
+
+        double score = play_match(&job, threads);
+        if (score < 0.0) {
+            return 1;
+        }
+
+        // score - 0.5 in [-0.5, 0.5]: a clean sweep moves each parameter by
+        // its step times the rate.
+        for (int i = 0; i < count; i++) {
+            values[i] += rate * params[i].step * 2.0 * (score - 0.5) * direction[i];
+            values[i] = values[i] < params[i].min ? params[i].min : (values[i] > params[i].max ? params[i].max : values[i]);
+        }
+
+        params_to_evaluator(params, values, &tuned);
+        if (!composed_evaluator_save(&tuned, output)) {
+            fprintf(stderr, "Cannot write '%s'.\n", output);
+            return 1;
+        }
+        fprintf(stderr, "iteration %d/%d: plus scored %.3f, %.1f s\n", k + 1, iterations, score,
+                (monotonic_ns() - start_ns) / 1e9);
+    }
+
+    if (verify_games > 0) {
+        job.first = tuned;
+        job.second = initial;
+        job.pairs = verify_games / 2 > 0 ? verify_games / 2 : 1;
+        job.seed = ~seed;
+        double score = play_match(&job, threads);
+        if (score < 0.0) {
+            return 1;
+        }
+        fprintf(stderr, "tuned against start: %.1f%% over %ld games at depth %d\n", score * 100.0, job.pairs * 2, depth);
+    }
+    return 0;
+}